@@ -0,0 +1,79 @@
+/**
+ * Duration
+ * Standalone timeline for Creative Code
+ *
+ * Copyright (c) 2012 James George
+ * Development Supported by YCAM InterLab http://interlab.ycam.jp/en/
+ * http://jamesgeorge.org + http://flightphase.com
+ * http://github.com/obviousjim + http://github.com/flightphase
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+
+#include "DurationAllocationCounter.h"
+
+#include <new>
+#include <cstdlib>
+
+#if !defined(DURATION_COUNT_ALLOCATIONS) && (defined(DEBUG) || defined(_DEBUG))
+#define DURATION_COUNT_ALLOCATIONS
+#endif
+
+#ifdef DURATION_COUNT_ALLOCATIONS
+
+static thread_local unsigned long long numAllocations = 0;
+
+void* operator new(std::size_t size){
+	numAllocations++;
+	void* memory = std::malloc(size > 0 ? size : 1);
+	if(memory == NULL){
+		throw std::bad_alloc();
+	}
+	return memory;
+}
+
+void* operator new[](std::size_t size){
+	return ::operator new(size);
+}
+
+void operator delete(void* memory) noexcept {
+	std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+	std::free(memory);
+}
+
+unsigned long long DurationAllocationCounter::getCount(){
+	return numAllocations;
+}
+
+#else
+
+unsigned long long DurationAllocationCounter::getCount(){
+	return 0;
+}
+
+#endif
@@ -0,0 +1,77 @@
+/**
+ * Duration
+ * Standalone timeline for Creative Code
+ *
+ * Copyright (c) 2012 James George
+ * Development Supported by YCAM InterLab http://interlab.ycam.jp/en/
+ * http://jamesgeorge.org + http://flightphase.com
+ * http://github.com/obviousjim + http://github.com/flightphase
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include "DurationControlQueue.h"
+
+DurationControlQueue::DurationControlQueue(){
+
+}
+
+void DurationControlQueue::add(const ofxOscMessage& message, bool coalesce){
+	mutex.lock();
+	if(coalesce){
+		string address = message.getAddress();
+		map<string, int>::iterator it = pendingAddresses.find(address);
+		if(it != pendingAddresses.end()){
+			//last value wins, keeping its original place in the queue
+			pending[it->second] = message;
+		}
+		else{
+			pendingAddresses[address] = pending.size();
+			pending.push_back(message);
+		}
+	}
+	else{
+		pending.push_back(message);
+	}
+	mutex.unlock();
+}
+
+bool DurationControlQueue::hasPending(){
+	mutex.lock();
+	bool waiting = !pending.empty();
+	mutex.unlock();
+	return waiting;
+}
+
+int DurationControlQueue::flush(ofxOscBundle& bundle){
+	mutex.lock();
+	int numMessages = pending.size();
+	for(int i = 0; i < numMessages; i++){
+		bundle.addMessage(pending[i]);
+	}
+	pending.clear();
+	pendingAddresses.clear();
+	mutex.unlock();
+	return numMessages;
+}
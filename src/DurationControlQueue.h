@@ -0,0 +1,57 @@
+/**
+ * Duration
+ * Standalone timeline for Creative Code
+ *
+ * Copyright (c) 2012 James George
+ * Development Supported by YCAM InterLab http://interlab.ycam.jp/en/
+ * http://jamesgeorge.org + http://flightphase.com
+ * http://github.com/obviousjim + http://github.com/flightphase
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#pragma once
+
+#include "ofMain.h"
+#include "ofxOsc.h"
+
+//Outgoing remote control writes from the GUI thread, drained by the OSC
+//thread. Continuous values (sliders) replace a pending write to the same
+//address so a drag only sends its latest value per flush; toggles and
+//buttons are kept in order so presses and releases both arrive.
+class DurationControlQueue {
+  public:
+	DurationControlQueue();
+
+	void add(const ofxOscMessage& message, bool coalesce);
+	bool hasPending();
+
+	//moves everything queued into the bundle in the order it was first queued
+	int flush(ofxOscBundle& bundle);
+
+  protected:
+	ofMutex mutex;
+	vector<ofxOscMessage> pending;
+	map<string, int> pendingAddresses; //address -> index in pending, for coalescing
+};
@@ -31,13 +31,33 @@
  */
 
 #include "DurationController.h"
+#include "DurationKeyframeAccess.h"
 #include "ofxHotKeys.h"
 
 #define DROP_DOWN_WIDTH 250
 #define TEXT_INPUT_WIDTH 100
+#define JOURNAL_COMPACT_BYTES (8 << 20)
+#define JOURNAL_SETTLE_SECONDS 1.0
 
 DurationController::DurationController(){
+	headless = false;
+	gui = NULL;
 	lastOSCBundleSent = 0;
+	remotePanelsCreated[0] = false;
+	remotePanelsCreated[1] = false;
+	remotePanelsMinified = false;
+	nextOSCBundleTime = 0;
+	curveValuesSent = 0;
+	curveValuesSuppressed = 0;
+	curvesChanged = false;
+	savesShown = 0;
+	saveFinishedTime = 0;
+	journalEditPending = false;
+	journalSaveGeneration = -1;
+	lastJournalEdit = 0;
+	deferredStart = 0;
+	bakeBudget = 0;
+	nextBakeCheck = 0;
 	shouldStartPlayback = false;
 	receivedAddTrack = false;
 	receivedPaletteToLoad = false;
@@ -45,7 +65,42 @@ DurationController::DurationController(){
 	enabled = false;
 	shouldCreateNewProject = false;
     shouldLoadProject = false;
+	shouldSaveProject = false;
 	audioTrack = NULL;
+	oscIndexDirty = true;
+	deferredTracksWanted = false;
+	timelineWasModal = false;
+	lastWakeupReport = 0;
+	droppedMessagesReported = 0;
+	controlFrequency = 1000. / 30;
+	lastControlFlush = 0;
+	oscWriterGrowths = 0;
+	steadyOscOutAllocations = 0;
+	receiver.setWakeup(&oscWakeup);
+
+	//control verbs are fixed, track addresses are indexed in rebuildOscIndex()
+	oscCommands["/duration/open"] = DURATION_OSC_OPEN;
+	oscCommands["/duration/new"] = DURATION_OSC_NEW;
+	oscCommands["/duration/save"] = DURATION_OSC_SAVE;
+	oscCommands["/duration/setduration"] = DURATION_OSC_SET_DURATION;
+	oscCommands["/duration/play"] = DURATION_OSC_PLAY;
+	oscCommands["/duration/stop"] = DURATION_OSC_STOP;
+	oscCommands["/duration/record"] = DURATION_OSC_RECORD;
+	oscCommands["/duration/seektosecond"] = DURATION_OSC_SEEK_TO_SECOND;
+	oscCommands["/duration/seektoposition"] = DURATION_OSC_SEEK_TO_POSITION;
+	oscCommands["/duration/seektomillis"] = DURATION_OSC_SEEK_TO_MILLIS;
+	oscCommands["/duration/seektotimecode"] = DURATION_OSC_SEEK_TO_TIMECODE;
+	oscCommands["/duration/enableoscout"] = DURATION_OSC_ENABLE_OSC_OUT;
+	oscCommands["/duration/oscrate"] = DURATION_OSC_OSC_RATE;
+	oscCommands["/duration/enableoscin"] = DURATION_OSC_ENABLE_OSC_IN;
+	oscCommands["/duration/addtrack"] = DURATION_OSC_ADD_TRACK;
+	oscCommands["/duration/removetrack"] = DURATION_OSC_REMOVE_TRACK;
+	oscCommands["/duration/trackname"] = DURATION_OSC_TRACK_NAME;
+	oscCommands["/duration/valuerange"] = DURATION_OSC_VALUE_RANGE;
+	oscCommands["/duration/valuerange/min"] = DURATION_OSC_VALUE_RANGE_MIN;
+	oscCommands["/duration/valuerange/max"] = DURATION_OSC_VALUE_RANGE_MAX;
+	oscCommands["/duration/colorpalette"] = DURATION_OSC_COLOR_PALETTE;
+	oscCommands["/duration/audioclip"] = DURATION_OSC_AUDIO_CLIP;
 }
 
 DurationController::~DurationController(){
@@ -56,14 +111,18 @@ void DurationController::enableInterface(){
 	if(!enabled){
 		enabled = true;
 		ofAddListener(ofEvents().update, this, &DurationController::update);
-		ofAddListener(ofEvents().draw, this, &DurationController::draw);
-		ofAddListener(ofEvents().keyPressed, this, &DurationController::keyPressed);
-		gui->enable();
-		gui->disableAppEventCallbacks();
+		if(!headless){
+			ofAddListener(ofEvents().draw, this, &DurationController::draw);
+			ofAddListener(ofEvents().keyPressed, this, &DurationController::keyPressed);
+			gui->enable();
+			gui->disableAppEventCallbacks();
+		}
 		timeline.enable();
 		map<string,ofPtr<ofxTLUIHeader> >::iterator it = headers.begin();
 		while(it != headers.end()){
-			it->second->getGui()->enable();
+			if(it->second->hasGui()){
+				it->second->getGui()->enable();
+			}
 			it++;
 		}
 	}
@@ -73,13 +132,17 @@ void DurationController::disableInterface(){
 	if(enabled){
 		enabled = false;
 		ofRemoveListener(ofEvents().update, this, &DurationController::update);
-		ofRemoveListener(ofEvents().draw, this, &DurationController::draw);
-		ofRemoveListener(ofEvents().keyPressed, this, &DurationController::keyPressed);
-		gui->disable();
+		if(!headless){
+			ofRemoveListener(ofEvents().draw, this, &DurationController::draw);
+			ofRemoveListener(ofEvents().keyPressed, this, &DurationController::keyPressed);
+			gui->disable();
+		}
 		timeline.disable();
 		map<string,ofPtr<ofxTLUIHeader> >::iterator it = headers.begin();
 		while(it != headers.end()){
-			it->second->getGui()->disable();
+			if(it->second->hasGui()){
+				it->second->getGui()->disable();
+			}
 			it++;
 		}
 	}
@@ -89,10 +152,18 @@ bool DurationController::isInterfaceEnabled(){
 	return enabled;
 }
 
-void DurationController::setup(){
+void DurationController::setup(bool headless, string projectPath){
+	this->headless = headless;
+
+	//startup is reported per phase so slow launches can be traced
+	unsigned long long setupStart = ofGetElapsedTimeMillis();
+	unsigned long long phaseStart = setupStart;
+	stringstream setupTimes;
 
 	#ifdef TARGET_WIN32
-	FreeConsole();
+	if(!headless){
+		FreeConsole();
+	}
 	#endif
 	if(!translation.load("languageFile.csv")){
 		ofLogError("DurationController::setup") << "error setting up translation, unpredictable stuff will happen" << endl;
@@ -101,6 +172,10 @@ void DurationController::setup(){
 	ofxXmlSettings defaultSettings;
 	bool settingsLoaded = defaultSettings.loadFile("settings.xml");	;
 	translation.setCurrentLanguage(defaultSettings.getValue("language", "english"));
+	//rate at which queued remote panel changes are sent, in bundles per second
+	controlFrequency = 1000. / MAX(defaultSettings.getValue("remoteControlRate", 30), 1);
+	//larger bundles are split so they are not fragmented or dropped on the way
+	sender.setMaxPacketSize(defaultSettings.getValue("oscMaxPacketSize", 1400));
 
 	if(!settingsLoaded){
 		defaultSettings.setValue("language", "english");
@@ -130,6 +205,9 @@ void DurationController::setup(){
     bMidiHotkeyLearning = false;
     midiHotkeyPressed = -1;
 
+	setupTimes << "settings " << ofGetElapsedTimeMillis() - phaseStart << " ms";
+	phaseStart = ofGetElapsedTimeMillis();
+
     //populate projects
     vector<string> projects;
     projects.push_back(translation.translateKey("new project..."));
@@ -146,27 +224,27 @@ void DurationController::setup(){
         projectDirectory.create(true);
     }
 
-    projectDirectory.listDir();
-    for(int i = 0; i < projectDirectory.size(); i++){
-        if(projectDirectory.getFile(i).isDirectory()){
-            ofDirectory subDir = ofDirectory(projectDirectory.getPath(i));
-			//cout << "checking path " << projectDirectory.getPath(i) << endl;
-            subDir.allowExt("durationproj");
-            subDir.setShowHidden(true);
-            subDir.listDir();
-            if(subDir.size() > 0){
-                projects.push_back(projectDirectory.getName(i));
-            }
-        }
-    }
+	//the last index is shown right away, folders that changed are listed in the background
+	if(!headless){
+		projectIndex.setup(ofToDataPath("projectIndex.xml"), defaultProjectDirectoryPath);
+		listedProjects = projectIndex.getProjects();
+		projects.insert(projects.end(), listedProjects.begin(), listedProjects.end());
+	}
+	setupTimes << ", project index " << ofGetElapsedTimeMillis() - phaseStart << " ms";
+	phaseStart = ofGetElapsedTimeMillis();
 
+	if(!headless){
 #ifdef TARGET_WIN32
-	timeline.setupFont("GUI/mplus-1c-regular.ttf", 9);
-	tooltipFont.loadFont("GUI/mplus-1c-regular.ttf", 7);
+		timeline.setupFont("GUI/mplus-1c-regular.ttf", 9);
+		tooltipFont.loadFont("GUI/mplus-1c-regular.ttf", 7);
 #else
-	timeline.setupFont("GUI/mplus-1c-regular.ttf", 10);
-	tooltipFont.loadFont("GUI/mplus-1c-regular.ttf", 5);
+		timeline.setupFont("GUI/mplus-1c-regular.ttf", 10);
+		tooltipFont.loadFont("GUI/mplus-1c-regular.ttf", 5);
 #endif
+	}
+	setupTimes << ", fonts " << ofGetElapsedTimeMillis() - phaseStart << " ms";
+	phaseStart = ofGetElapsedTimeMillis();
+
 	//setup timeline
 	timeline.setup();
 //	timeline.curvesUseBinary = true; //ELOI SWITCH THIS HERE
@@ -179,7 +257,53 @@ void DurationController::setup(){
 	timeline.setAutosave(false);
 	timeline.setEditableHeaders(true);
 	timeline.moveToThread(); //increases accuracy of bang call backs
+	setupTimes << ", timeline " << ofGetElapsedTimeMillis() - phaseStart << " ms";
+	phaseStart = ofGetElapsedTimeMillis();
+
+	if(!headless){
+		createTopGui(projects);
+	}
+
+	//add events
+    ofAddListener(timeline.events().bangFired, this, &DurationController::bangFired);
+	ofAddListener(ofEvents().exit, this, &DurationController::exit);
+
+    //SET UP LISENTERS
+	enableInterface();
+	setupTimes << ", interface " << ofGetElapsedTimeMillis() - phaseStart << " ms";
+	phaseStart = ofGetElapsedTimeMillis();
+
+    if(projectPath != ""){
+        loadProject(projectPath);
+    }
+    else if(settingsLoaded){
+        string lastProjectPath = defaultSettings.getValue("lastProjectPath", "");
+        string lastProjectName = defaultSettings.getValue("lastProjectName", "");
+        if(lastProjectPath != "" && lastProjectName != "" && ofDirectory(lastProjectPath).exists()){
+            loadProject(lastProjectPath, lastProjectName);
+        }
+        else{
+            ofLogError() << "Duration -- Last project was not found, creating a new project";
+            loadProject(ofToDataPath(defaultProjectDirectoryPath+"Sample Project"), "Sample Project", true);
+        }
+    }
+    else {
+//        cout << "Loading sample project " << defaultProjectDirectoryPath << endl;
+        loadProject(ofToDataPath(defaultProjectDirectoryPath+"Sample Project"), "Sample Project", true);
+    }
+	setupTimes << ", project " << ofGetElapsedTimeMillis() - phaseStart << " ms";
+	phaseStart = ofGetElapsedTimeMillis();
+	if(!headless){
+		createTooltips();
+	}
+	setupTimes << ", tooltips " << ofGetElapsedTimeMillis() - phaseStart << " ms";
 
+	startThread();
+	//remote panels are not part of startup, createRemotePanels() reports them when first shown
+	ofLogNotice("DurationController::setup") << "Started" << (headless ? " headless" : "") << " in " << ofGetElapsedTimeMillis() - setupStart << " ms (" << setupTimes.str() << ")";
+}
+//--------------------------------------------------------------
+void DurationController::createTopGui(vector<string>& projects){
 	//Set up top GUI
     gui = new ofxUICanvas(0,0,ofGetWidth(), 90);
 
@@ -243,6 +367,7 @@ void DurationController::setup(){
     //SETUP OSC CONTROLS
     enableOSCInToggle = new ofxUILabelToggle(translation.translateKey("OSC IN"),false,0,0,0,0, OFX_UI_FONT_MEDIUM);
     enableOSCOutToggle = new ofxUILabelToggle(translation.translateKey("OSC OUT"),false,0,0,0,0, OFX_UI_FONT_MEDIUM);
+    multicastToggle = new ofxUILabelToggle(translation.translateKey("MULTICAST"),false,0,0,0,0, OFX_UI_FONT_MEDIUM);
     oscOutIPInput = new ofxUITextInput("OSCIP", "127.0.0.1",TEXT_INPUT_WIDTH*1.5,0,0,0, OFX_UI_FONT_MEDIUM);
     oscOutIPInput->setAutoClear(false);
     oscOutIPInput = new ofxUITextInput("DISPLAY2IP", "127.0.0.1",TEXT_INPUT_WIDTH*1.5, 0, 150, 150,OFX_UI_FONT_MEDIUM );
@@ -257,33 +382,45 @@ void DurationController::setup(){
 	gui->addWidgetRight(enableOSCInToggle);
     gui->addWidgetRight(oscInPortInput);
     gui->addWidgetRight(enableOSCOutToggle);
+    gui->addWidgetRight(multicastToggle);
     gui->addWidgetRight(oscOutIPInput);
     gui->addWidgetRight(oscOutPortInput);
 
 	ofAddListener(gui->newGUIEvent, this, &DurationController::guiEvent);
+}
 
-	//add events
-    ofAddListener(timeline.events().bangFired, this, &DurationController::bangFired);
-	ofAddListener(ofEvents().exit, this, &DurationController::exit);
-
-    //SET UP LISENTERS
-	enableInterface();
+//--------------------------------------------------------------
+//the LPMT remote panels are built the first time F3 or F4 shows them, sessions
+//that stay on the timeline never pay for their widgets
+void DurationController::createRemotePanels(int page){
+	if(remotePanelsCreated[page]){
+		return;
+	}
+	remotePanelsCreated[page] = true;
+	unsigned long long start = ofGetElapsedTimeMillis();
+	vector<ofxUICanvas*> panels;
+	if(page == 0){
+		createRemotePanelsF3();
+		ofxUICanvas* created[] = {gui0, gui1, gui2, gui3, gui4, gui5};
+		panels.assign(created, created + 6);
+	}
+	else{
+		createRemotePanelsF4();
+		ofxUICanvas* created[] = {gui6, gui7, gui8, gui9, gui11};
+		panels.assign(created, created + 5);
+	}
+	int numWidgets = 0;
+	for(int i = 0; i < panels.size(); i++){
+		remoteMap.addCanvas(panels[i]);
+		if(remotePanelsMinified && panels[i] != gui5){
+			panels[i]->setMinified(true);
+		}
+		numWidgets += panels[i]->getWidgets().size();
+	}
+	ofLogNotice("DurationController") << "Built " << panels.size() << " remote panels with " << numWidgets << " widgets in " << ofGetElapsedTimeMillis() - start << " ms";
+}
 
-    if(settingsLoaded){
-        string lastProjectPath = defaultSettings.getValue("lastProjectPath", "");
-        string lastProjectName = defaultSettings.getValue("lastProjectName", "");
-        if(lastProjectPath != "" && lastProjectName != "" && ofDirectory(lastProjectPath).exists()){
-            loadProject(lastProjectPath, lastProjectName);
-        }
-        else{
-            ofLogError() << "Duration -- Last project was not found, creating a new project";
-            loadProject(ofToDataPath(defaultProjectDirectoryPath+"Sample Project"), "Sample Project", true);
-        }
-    }
-    else {
-//        cout << "Loading sample project " << defaultProjectDirectoryPath << endl;
-        loadProject(ofToDataPath(defaultProjectDirectoryPath+"Sample Project"), "Sample Project", true);
-    }
+void DurationController::createRemotePanelsF3(){
         //--GUI0--------------------------------------------------------
     gui0 = new ofxUISuperCanvas("Input");
     gui0->setPosition(0, 90);
@@ -492,7 +629,9 @@ void DurationController::setup(){
     gui5->autoSizeToFitWidgets();
     //gui5->getRect()->setWidth(ofGetWidth());
     ofAddListener(gui5->newGUIEvent,this,&DurationController::guiEvent);
+}
 
+void DurationController::createRemotePanelsF4(){
 //----GUI6------------------------------------------------------
 
     gui6 = new ofxUISuperCanvas("Capture & CV");
@@ -657,12 +796,6 @@ void DurationController::setup(){
 
     gui11->autoSizeToFitWidgets();
     ofAddListener(gui11->newGUIEvent,this,&DurationController::guiEvent);
-
-
-
-	createTooltips();
-
-	startThread();
 }
 void DurationController::panelGui(){
 
@@ -670,72 +803,174 @@ void DurationController::panelGui(){
 }
 void DurationController::threadedFunction(){
 	while(isThreadRunning()){
-		lock();
-		oscLock.lock();
-		handleOscIn();
-		handleOscOut();
-		oscLock.unlock();
-		unlock();
+		//messages are decoded on the receiver's thread, only applying them needs the timeline
+		if(receiver.hasWaitingMessages()){
+			lock();
+			handleOscIn();
+			unlock();
+		}
+
+		unsigned long now = recordTimer.getAppTimeMillis();
+		if(controlQueue.hasPending() && now >= lastControlFlush + controlFrequency){
+			flushControlQueue();
+		}
+
+		if(settings.oscOutEnabled){
+			lock();
+			oscLock.lock();
+			//edits, index rebuilds, bangs and buffer growth allocate, any other bundle shouldn't
+			bool steady = !oscIndexDirty && !curvesChanged && bangsReceived.empty();
+			int growths = oscWriter.getNumGrowths();
+			unsigned long long allocations = DurationAllocationCounter::getCount();
+			handleOscOut();
+			if(steady && oscWriter.getNumGrowths() == growths){
+				steadyOscOutAllocations += DurationAllocationCounter::getCount() - allocations;
+			}
+			oscLock.unlock();
+			unlock();
+		}
+
+		//sleep until the next bundle or control flush is due, or until the next report if neither is
+		now = recordTimer.getAppTimeMillis();
+		bool timed = false;
+		unsigned long deadline = 0;
+		if(settings.oscOutEnabled){
+			deadline = nextOSCBundleTime;
+			timed = true;
+		}
+		if(controlQueue.hasPending()){
+			unsigned long nextFlush = ceil(lastControlFlush + controlFrequency);
+			deadline = timed ? MIN(deadline, nextFlush) : nextFlush;
+			timed = true;
+		}
+		if(!timed){
+			//the record timer restarts with recording, report right away then to catch up
+			deadline = now >= lastWakeupReport ? lastWakeupReport + 10000 : now;
+		}
+		oscWakeup.waitForMicros(deadline > now ? (deadline - now) * 1000 : 0);
+
+		now = recordTimer.getAppTimeMillis();
+		if(now - lastWakeupReport >= 10000){
+			ofLogVerbose("DurationController") << "OSC thread wake latency max " << oscWakeup.getMaxLatencyMicros() << " micros, last " << oscWakeup.getLastLatencyMicros() << " micros";
+			if(receiver.getScheduledBundles() > 0){
+				ofLogNotice("DurationController") << "Time tagged bundles received " << receiver.getScheduledBundles() << ", late " << receiver.getLateBundles()
+					<< ", arrived " << receiver.getMinMarginMillis() << " to " << receiver.getMaxMarginMillis() << " ms early, jitter " << receiver.getMarginDeviationMillis() << " ms";
+				receiver.resetTimetagStats();
+			}
+			if(curveValuesSuppressed > 0){
+				ofLogVerbose("DurationController") << "Curve values sent " << curveValuesSent << ", held back by deadband or quantization " << curveValuesSuppressed;
+			}
+			curveValuesSent = 0;
+			curveValuesSuppressed = 0;
+			int keyframeSearches = 0;
+			for(int i = 0; i < outputDescriptors.size(); i++){
+				keyframeSearches += outputDescriptors[i].cursor.getNumSearches();
+				outputDescriptors[i].cursor.resetSearches();
+			}
+			if(keyframeSearches > 0){
+				ofLogVerbose("DurationController") << "Curve keyframes searched from scratch " << keyframeSearches << " times after seeks, loops or edits";
+			}
+			if(receiver.getDroppedMessages() != droppedMessagesReported){
+				ofLogWarning("DurationController") << "OSC input ring was full, dropped " << receiver.getDroppedMessages() - droppedMessagesReported << " incoming messages";
+				droppedMessagesReported = receiver.getDroppedMessages();
+			}
+			if(steadyOscOutAllocations > 0){
+				ofLogWarning("DurationController") << "OSC output allocated " << steadyOscOutAllocations << " times in bundles with no edits to apply";
+				steadyOscOutAllocations = 0;
+			}
+			oscWakeup.resetLatency();
+			lastWakeupReport = now;
+		}
+	}
+}
 
-		ofSleepMillis(1);
+void DurationController::flushControlQueue(){
+	ofxOscBundle bundle;
+	if(controlQueue.flush(bundle) == 0){
+		return;
 	}
+	oscLock.lock();
+	sender.sendBundle(bundle);
+	oscLock.unlock();
+	lastControlFlush = recordTimer.getAppTimeMillis();
 }
 
 void DurationController::handleOscIn(){
 	if(!settings.oscInEnabled){
+		receiver.clear();
 		return;
 	}
 
-	//TODO: move parsing and receing to separate different threads?
 	long timelineStartTime = timeline.getCurrentTimeMillis();
-	while(receiver.hasWaitingMessages()){
+	ofxOscMessage m;
+	while(receiver.getNextMessage(&m)){
 
-		ofxOscMessage m;
-		receiver.getNextMessage(&m);
+		if(oscIndexDirty){
+			rebuildOscIndex();
+		}
+
+		string address = m.getAddress();
 		bool handled = false;
 		long startTime = recordTimer.getAppTimeMicros();
-		vector<ofxTLPage*>& pages = timeline.getPages();
-		for(int i = 0; i < pages.size(); i++){
-			vector<ofxTLTrack*>& tracks = pages[i]->getTracks();
-			for(int t = 0; t < tracks.size(); t++){
-//				cout << " testing against " << "/"+tracks[t]->getDisplayName() << endl;
-				ofxTLTrack* track = tracks[t];
-				ofPtr<ofxTLUIHeader> header = headers[track->getName()];
-				if(header->receiveOSC() && m.getAddress() == ofFilePath::addLeadingSlash(track->getDisplayName()) ){
-
-					if(timeline.getIsPlaying() ){ //TODO: change to isPlaying() && isRecording()
-						if(track->getTrackType() == "Curves"){
-							ofxTLCurves* curves = (ofxTLCurves*)track;
-//							cout << "adding value " << m.getArgAsFloat(0) << endl;
-							if(m.getArgType(0) == OFXOSC_TYPE_FLOAT){
-								float value = m.getArgAsFloat(0);
-								if(value != header->lastValueReceived || !header->hasReceivedValue){
-									curves->addKeyframeAtMillis(value, timelineStartTime);
-									header->lastValueReceived = value;
-									header->hasReceivedValue = true;
+		unordered_map<string, vector<ofPtr<ofxTLUIHeader> > >::iterator trackit = oscTrackAddresses.find(address);
+		if(trackit != oscTrackAddresses.end()){
+			vector<ofPtr<ofxTLUIHeader> >& addressHeaders = trackit->second;
+			for(int i = 0; i < addressHeaders.size(); i++){
+				ofPtr<ofxTLUIHeader> header = addressHeaders[i];
+				if(!header->receiveOSC()){
+					continue;
+				}
+
+				ofxTLTrack* track = header->getTrack();
+				if(timeline.getIsPlaying() && header->keysDeferred){
+					//recorded keys go on top of the saved ones, which the main thread reads
+					//on the next frame. reading them here would hold up the lock
+					deferredTracksWanted = true;
+				}
+				else if(timeline.getIsPlaying() ){ //TODO: change to isPlaying() && isRecording()
+					if(track->getTrackType() == "Curves"){
+						ofxTLCurves* curves = (ofxTLCurves*)track;
+//						cout << "adding value " << m.getArgAsFloat(0) << endl;
+						if(m.getArgType(0) == OFXOSC_TYPE_FLOAT){
+							float value = m.getArgAsFloat(0);
+							if(value != header->lastValueReceived || !header->hasReceivedValue){
+								curves->addKeyframeAtMillis(value, timelineStartTime);
+								journal.addKey(track->getName(), timelineStartTime, value);
+								unordered_map<ofxTLUIHeader*, int>::iterator output = outputsByHeader.find(header.get());
+								if(output != outputsByHeader.end() && outputDescriptors[output->second].bake != NULL){
+									outputDescriptors[output->second].bake->keyAdded(timelineStartTime);
 								}
+								header->lastValueReceived = value;
+								header->hasReceivedValue = true;
 							}
 						}
-						else if(track->getTrackType() == "Bangs"){
-							ofxTLBangs* bangs = (ofxTLBangs*)track;
-							bangs->addKeyframeAtMillis(0,timelineStartTime);
-						}
 					}
-
-					header->lastInputReceivedTime = recordTimer.getAppTimeSeconds();
-					handled = true;
+					else if(track->getTrackType() == "Bangs"){
+						ofxTLBangs* bangs = (ofxTLBangs*)track;
+						bangs->addKeyframeAtMillis(0,timelineStartTime);
+						journal.addKey(track->getName(), timelineStartTime, 0);
+					}
 				}
+
+				header->lastInputReceivedTime = recordTimer.getAppTimeSeconds();
+				handled = true;
 			}
 		}
 
 		long endTime = recordTimer.getAppTimeMicros();
 //		cout << "receiving message took " << (endTime - startTime) << " micros " << endl;
 		if(handled){
-			return;
+			continue;
+		}
+
+		unordered_map<string, DurationOscCommand>::iterator commandit = oscCommands.find(address);
+		if(commandit == oscCommands.end()){
+			continue;
 		}
 
 		//check for playback messages
-		if(m.getAddress() == "/duration/open"){
+		switch(commandit->second){
+		case DURATION_OSC_OPEN:{
 			if(m.getNumArgs() == 1 && m.getArgType(0) == OFXOSC_TYPE_STRING){
 				string projectPath = m.getArgAsString(0);
 				shouldLoadProject = true;
@@ -749,8 +984,9 @@ void DurationController::handleOscIn(){
 			else{
 				ofLogError("Duration:OSC") << " Open Project Failed - must have on string argument specifying project name or absolute path";
 			}
+			break;
 		}
-		else if(m.getAddress() == "/duration/new"){
+		case DURATION_OSC_NEW:{
 			if(m.getNumArgs() == 1 && m.getArgType(0) == OFXOSC_TYPE_STRING){
 				string path = m.getArgAsString(0);
 				shouldCreateNewProject = true;
@@ -765,37 +1001,39 @@ void DurationController::handleOscIn(){
 			else{
 				ofLogError("Duration:OSC") << " New Project Failed - must have on string argument specifying the new project path";
 			}
+			break;
 		}
-		else if(m.getAddress() == "/duration/save"){
-			saveProject();
+		case DURATION_OSC_SAVE:{
+			shouldSaveProject = true;
+			break;
 		}
-		else if(m.getAddress() == "/duration/setduration"){
+		case DURATION_OSC_SET_DURATION:{
 			if(m.getNumArgs() == 1){
 				//seconds
 				if(m.getArgType(0) == OFXOSC_TYPE_FLOAT){
 					timeline.setDurationInSeconds(m.getArgAsFloat(0));
-					durationLabel->setTextString(timeline.getDurationInTimecode());
 				}
 				//timecode
 				else if(m.getArgType(0) == OFXOSC_TYPE_STRING){
 					timeline.setDurationInTimecode(m.getArgAsString(0));
-					durationLabel->setTextString(timeline.getDurationInTimecode());
 				}
 				//millis
 				else if(m.getArgType(0) == OFXOSC_TYPE_INT32){
 					timeline.setDurationInMillis(m.getArgAsInt32(0));
-					durationLabel->setTextString(timeline.getDurationInTimecode());
 				}
 				else if(m.getArgType(0) == OFXOSC_TYPE_INT64){
 					timeline.setDurationInMillis(m.getArgAsInt64(0));
+				}
+				if(!headless){
 					durationLabel->setTextString(timeline.getDurationInTimecode());
 				}
 			}
 			else {
 				ofLogError("Duration:OSC") << " Set Duration failed - must have one argument. seconds as float, timecode string HH:MM:SS:MILS, or integer as milliseconds";
 			}
+			break;
 		}
-		else if(m.getAddress() == "/duration/play"){
+		case DURATION_OSC_PLAY:{
 			if(m.getNumArgs() == 0){
 				if(!timeline.getIsPlaying()){
 					shouldStartPlayback = true;
@@ -811,8 +1049,9 @@ void DurationController::handleOscIn(){
 					}
 				}
 			}
+			break;
 		}
-		else if(m.getAddress() == "/duration/stop"){
+		case DURATION_OSC_STOP:{
 			if(m.getNumArgs() == 0){
 				if(timeline.getIsPlaying()){
 					timeline.stop();
@@ -831,21 +1070,24 @@ void DurationController::handleOscIn(){
 					}
 				}
 			}
+			break;
 		}
-		else if(m.getAddress() == "/duration/record"){
+		case DURATION_OSC_RECORD:{
 			//TODO: turn on record mode
 			shouldStartPlayback = true;
 			//startPlayback();
+			break;
 		}
-		else if(m.getAddress() == "/duration/seektosecond"){
+		case DURATION_OSC_SEEK_TO_SECOND:{
 			if(m.getArgType(0) == OFXOSC_TYPE_FLOAT){
 				timeline.setCurrentTimeSeconds(m.getArgAsFloat(0));
 			}
 			else{
 				ofLogError("Duration:OSC") << " Seek to Second failed: first argument must be a float";
 			}
+			break;
 		}
-		else if(m.getAddress() == "/duration/seektoposition"){
+		case DURATION_OSC_SEEK_TO_POSITION:{
 			if(m.getArgType(0) == OFXOSC_TYPE_FLOAT){
 				float percent = ofClamp(m.getArgAsFloat(0),0.0,1.0);
 				timeline.setPercentComplete(percent);
@@ -853,8 +1095,9 @@ void DurationController::handleOscIn(){
 			else{
 				ofLogError("Duration:OSC") << " Seek to Position failed: first argument must be a float between 0.0 and 1.0";
 			}
+			break;
 		}
-		else if(m.getAddress() == "/duration/seektomillis"){
+		case DURATION_OSC_SEEK_TO_MILLIS:{
 			if(m.getArgType(0) == OFXOSC_TYPE_INT32){
 				timeline.setCurrentTimeMillis(m.getArgAsInt32(0));
 			}
@@ -864,8 +1107,9 @@ void DurationController::handleOscIn(){
 			else{
 				ofLogError("Duration:OSC") << " Seek to Millis failed: first argument must be a int 32 or in 64";
 			}
+			break;
 		}
-		else if(m.getAddress() == "/duration/seektotimecode"){
+		case DURATION_OSC_SEEK_TO_TIMECODE:{
 			if(m.getArgType(0) == OFXOSC_TYPE_STRING){
 				long millis = ofxTimecode::millisForTimecode(m.getArgAsString(0));
 				if(millis > 0){
@@ -878,13 +1122,16 @@ void DurationController::handleOscIn(){
 			else{
 				ofLogError("Duration:OSC") << " Seek to Timecode failed: first argument must be a string";
 			}
+			break;
 		}
 		//enable and disable OSC
-		else if(m.getAddress() == "/duration/enableoscout"){
+		case DURATION_OSC_ENABLE_OSC_OUT:{
 			//system wide
 			if(m.getNumArgs() == 1 && m.getArgType(0) == OFXOSC_TYPE_INT32){
 				settings.oscOutEnabled = m.getArgAsInt32(0) != 0;
-				enableOSCOutToggle->setValue(settings.oscOutEnabled);
+				if(!headless){
+					enableOSCOutToggle->setValue(settings.oscOutEnabled);
+				}
 			}
 			//per track
 			else if(m.getNumArgs() == 2 &&
@@ -903,8 +1150,9 @@ void DurationController::handleOscIn(){
 			else{
 				ofLogError("Duration:OSC") << " Enable OSC out incorrectly formatted arguments. usage: /duration/enableoscout enable:int32 == (1 or 0), or /duration/enableoscout trackname:string enable:int32 (1 or 0)";
 			}
+			break;
 		}
-		else if(m.getAddress() == "/duration/oscrate"){
+		case DURATION_OSC_OSC_RATE:{
 			if(m.getNumArgs() == 1){
 				if(m.getArgType(0) == OFXOSC_TYPE_INT32){
 					settings.oscRate = m.getArgAsInt32(0);
@@ -922,12 +1170,15 @@ void DurationController::handleOscIn(){
 					ofLogError("Duration:OSC") << " Set OSC rate failed. must specify an int or a float as the first parameter";
 				}
 			}
+			break;
 		}
-		else if(m.getAddress() == "/duration/enableoscin"){
+		case DURATION_OSC_ENABLE_OSC_IN:{
 			//system wide -- don't quite know what to do as this will turn off all osc
 			if(m.getNumArgs() == 1 && m.getArgType(0) == OFXOSC_TYPE_INT32){
 				settings.oscInEnabled = m.getArgAsInt32(0) != 0;
-				enableOSCInToggle->setValue(settings.oscInEnabled);
+				if(!headless){
+					enableOSCInToggle->setValue(settings.oscInEnabled);
+				}
 			}
 			//per track
 			else if(m.getNumArgs() == 2 && m.getArgType(0) == OFXOSC_TYPE_STRING && m.getArgType(1) == OFXOSC_TYPE_INT32){
@@ -943,9 +1194,10 @@ void DurationController::handleOscIn(){
 			else{
 				ofLogError("Duration:OSC") << "Enable OSC in incorrectly formatted arguments. usage: /duration/enableoscout enable:int32 == (1 or 0), or /duration/enableoscout trackname:string enable:int32 (1 or 0)";
 			}
+			break;
 		}
 		//adding and removing tracks
-		else if(m.getAddress() == "/duration/addtrack"){
+		case DURATION_OSC_ADD_TRACK:{
 			//type,
 			receivedAddTrack = false;
 			oscTrackTypeReceived = "";
@@ -970,8 +1222,9 @@ void DurationController::handleOscIn(){
 			if(!receivedAddTrack){
 				ofLogError("Duration:OSC") << "Add track failed, incorrectly formatted arguments. \n usage: /duration/addtrack type:string [optional name:string ] [optional filepath:string ]";
 			}
+			break;
 		}
-		else if(m.getAddress() == "/duration/removetrack"){
+		case DURATION_OSC_REMOVE_TRACK:{
 			if(m.getNumArgs() == 1 && m.getArgType(0) == OFXOSC_TYPE_STRING){
 				string trackName = m.getArgAsString(0);
 				ofPtr<ofxTLUIHeader> header = getHeaderWithDisplayName(trackName);
@@ -985,8 +1238,9 @@ void DurationController::handleOscIn(){
 			else {
 				ofLogError("Duration:OSC") << "Remove track failed, incorrectly formatted arguments. \n usage: /duration/removetrack name:string";
 			}
+			break;
 		}
-		else if(m.getAddress() == "/duration/trackname"){
+		case DURATION_OSC_TRACK_NAME:{
 			if(m.getNumArgs() == 2 &&
 			   m.getArgType(0) == OFXOSC_TYPE_STRING &&
 			   m.getArgType(1) == OFXOSC_TYPE_STRING)
@@ -995,6 +1249,7 @@ void DurationController::handleOscIn(){
 				ofPtr<ofxTLUIHeader> header = getHeaderWithDisplayName(trackName);
 				if(header != NULL){
 					header->getTrack()->setDisplayName(m.getArgAsString(1));
+					oscIndexDirty = true;
 				}
 				else{
 					ofLogError("Duration:OSC") << "Set Track Name failed, could not find track " << trackName;
@@ -1003,8 +1258,9 @@ void DurationController::handleOscIn(){
 			else{
 				ofLogError("Duration:OSC") << "Set Track Name failed, incorrectly formatted arguments. \n usage: /duration/trackname oldname:string newname:string";
 			}
+			break;
 		}
-		else if(m.getAddress() == "/duration/valuerange"){
+		case DURATION_OSC_VALUE_RANGE:{
 			if(m.getNumArgs() == 3 &&
 			   m.getArgType(0) == OFXOSC_TYPE_STRING && //track name
 			   m.getArgType(1) == OFXOSC_TYPE_FLOAT && //min
@@ -1015,6 +1271,7 @@ void DurationController::handleOscIn(){
 				if(header != NULL){
 					if(header->getTrackType() == "Curves" || header->getTrackType() == "LFO"){
 						header->setValueRange(ofRange(m.getArgAsFloat(1),m.getArgAsFloat(2)));
+						curvesChanged = true;
 					}
 					else {
 						ofLogError("Duration:OSC") << "Set value range failed, track is not a Curves track " << trackName;
@@ -1027,8 +1284,9 @@ void DurationController::handleOscIn(){
 			else {
 				ofLogError("Duration:OSC") << "Set value range failed, incorrectly formatted message. \n usage: /duration/valuerange trackname:string min:float max:float";
 			}
+			break;
 		}
-		else if(m.getAddress() == "/duration/valuerange/min"){
+		case DURATION_OSC_VALUE_RANGE_MIN:{
 			if(m.getNumArgs() == 2 &&
 			   m.getArgType(0) == OFXOSC_TYPE_STRING && //track name
 			   m.getArgType(1) == OFXOSC_TYPE_FLOAT) //min
@@ -1038,6 +1296,7 @@ void DurationController::handleOscIn(){
 				if(header != NULL){
 					if(header->getTrackType() == "Curves" || header->getTrackType() == "LFO"){
 						header->setValueMin(m.getArgAsFloat(1));
+						curvesChanged = true;
 					}
 					else{
 						ofLogError("Duration:OSC") << "Set value range min failed, track is not a Curves track " << trackName;
@@ -1050,8 +1309,9 @@ void DurationController::handleOscIn(){
 			else{
 				ofLogError("Duration:OSC") << "Set value range min failed. Incorrectly formatted arguments \n usage: /duration/valuerange/min trackname:string";
 			}
+			break;
 		}
-		else if(m.getAddress() == "/duration/valuerange/max"){
+		case DURATION_OSC_VALUE_RANGE_MAX:{
 			if(m.getNumArgs() == 2 &&
 			   m.getArgType(0) == OFXOSC_TYPE_STRING && //track name
 			   m.getArgType(1) == OFXOSC_TYPE_FLOAT) //max
@@ -1061,6 +1321,7 @@ void DurationController::handleOscIn(){
 				if(header != NULL){
 					if(header->getTrackType() == "Curves" || header->getTrackType() == "LFO"){
 						header->setValueMax(m.getArgAsFloat(1));
+						curvesChanged = true;
 					}
 					else{
 						ofLogError("Duration:OSC") << "Set value range max failed, track is not a Curves track " << trackName;
@@ -1073,8 +1334,9 @@ void DurationController::handleOscIn(){
 			else{
 				ofLogError("Duration:OSC") << "Set value range min failed. Incorrectly formatted arguments \n usage: /duration/valuerange/min trackname:string";
 			}
+			break;
 		}
-		else if(m.getAddress() == "/duration/colorpalette"){
+		case DURATION_OSC_COLOR_PALETTE:{
 			if(m.getNumArgs() == 2 &&
 			   m.getArgType(0) == OFXOSC_TYPE_STRING && //track name
 			   m.getArgType(1) == OFXOSC_TYPE_STRING) //file path
@@ -1095,8 +1357,9 @@ void DurationController::handleOscIn(){
 			else{
 				ofLogError("Duration:OSC") << "Set color palette failed, incorrectly formatted arguments \n usage: /duration/colorpalette trackname:string imagefilepath:string";
 			}
+			break;
 		}
-		else if(m.getAddress() == "/duration/audioclip"){
+		case DURATION_OSC_AUDIO_CLIP:{
 			if(m.getNumArgs() == 1 && m.getArgType(0) == OFXOSC_TYPE_STRING){
 				if(audioTrack != NULL){
 					if(!audioTrack->loadSoundfile(m.getArgAsString(0))){
@@ -1110,8 +1373,94 @@ void DurationController::handleOscIn(){
 			else{
 				ofLogError("Duration:OSC") << "Set audio clip failed, incorrectly formatted arguments. \n usage /duration/audioclip filepath:string ";
 			}
+			break;
+		}
+		}
+	}
+}
+
+//called with the timeline locked whenever tracks were added, renamed or removed
+void DurationController::rebuildOscIndex(){
+	//keep what was last sent for tracks that survive the rebuild. keyed by header,
+	//since the old descriptors keep their headers alive but a removed track is gone
+	map<ofxTLUIHeader*, DurationOutputDescriptor> previousOutputs;
+	for(int i = 0; i < outputDescriptors.size(); i++){
+		previousOutputs[outputDescriptors[i].header.get()] = outputDescriptors[i];
+	}
+	outputDescriptors.clear();
+	outputsByHeader.clear();
+
+	oscTrackAddresses.clear();
+	vector<ofxTLPage*>& pages = timeline.getPages();
+	for(int i = 0; i < pages.size(); i++){
+		vector<ofxTLTrack*>& tracks = pages[i]->getTracks();
+		for(int t = 0; t < tracks.size(); t++){
+			map<string, ofPtr<ofxTLUIHeader> >::iterator it = headers.find(tracks[t]->getName());
+			if(it == headers.end()){
+				continue;
+			}
+			string address = ofFilePath::addLeadingSlash(tracks[t]->getDisplayName());
+			oscTrackAddresses[address].push_back(it->second);
+
+			DurationOutputDescriptor output;
+			string trackType = it->second->getTrackType();
+			if(trackType == "Curves" || trackType == "LFO"){
+				output.type = DURATION_OUTPUT_CURVES;
+			}
+			else if(trackType == "Switches"){
+				output.type = DURATION_OUTPUT_SWITCHES;
+			}
+			else if(trackType == "Colors"){
+				output.type = DURATION_OUTPUT_COLORS;
+			}
+			else if(trackType == "Audio"){
+				output.type = DURATION_OUTPUT_AUDIO;
+			}
+			else {
+				//bangs and flags are sent from bangFired
+				continue;
+			}
+			output.track = tracks[t];
+			output.header = it->second;
+			output.address = address;
+			output.prefixArgs = -1;
+			output.forceSend = false;
+			output.batchColumn = -1;
+			if(output.type == DURATION_OUTPUT_CURVES){
+				output.cursor.setup((ofxTLKeyframes*)tracks[t], trackType == "Curves");
+			}
+			switch(output.type){
+				case DURATION_OUTPUT_CURVES:   DurationOscWriter::buildPrefix(address, ",f", output.prefix); break;
+				case DURATION_OUTPUT_SWITCHES: DurationOscWriter::buildPrefix(address, ",i", output.prefix); break;
+				case DURATION_OUTPUT_COLORS:   DurationOscWriter::buildPrefix(address, ",iii", output.prefix); break;
+				default: break;
+			}
+
+			map<ofxTLUIHeader*, DurationOutputDescriptor>::iterator previous = previousOutputs.find(it->second.get());
+			if(previous != previousOutputs.end()){
+				output.nextSendTime = previous->second.nextSendTime;
+				output.hasSentValue = previous->second.hasSentValue;
+				output.lastSentTime = previous->second.lastSentTime;
+				output.lastFloatSampled = previous->second.lastFloatSampled;
+				output.lastFloatSent = previous->second.lastFloatSent;
+				output.lastBoolSent = previous->second.lastBoolSent;
+				output.lastColorSent = previous->second.lastColorSent;
+				output.bake = previous->second.bake;
+			}
+			else{
+				output.nextSendTime = 0;
+				output.hasSentValue = false;
+				output.lastSentTime = 0;
+				output.lastFloatSampled = 0;
+				output.lastFloatSent = 0;
+				output.lastBoolSent = false;
+				output.lastColorSent = ofColor(0,0,0);
+			}
+			outputDescriptors.push_back(output);
+			outputsByHeader[output.header.get()] = outputDescriptors.size() - 1;
 		}
 	}
+	oscIndexDirty = false;
 }
 
 void DurationController::handleOscOut(){
@@ -1121,96 +1470,296 @@ void DurationController::handleOscOut(){
 	}
 
 	unsigned long bundleTime = recordTimer.getAppTimeMillis();
-	if(lastOSCBundleSent+oscFrequency > bundleTime){
+	//the record timer restarts when recording starts, start the schedule over with it
+	if(bundleTime < lastOSCBundleSent){
+		nextOSCBundleTime = 0;
+		for(int i = 0; i < outputDescriptors.size(); i++){
+			outputDescriptors[i].nextSendTime = 0;
+			outputDescriptors[i].lastSentTime = 0;
+		}
+	}
+	if(bundleTime < nextOSCBundleTime){
 		return;
 	}
 	//cout << "OSC RATE IS " << settings.oscRate << " osc FREQUENCY is " << oscFrequency << " sending num at record timer " << recordTimer.getAppTimeMillis() << endl;
 
 	unsigned long timelineSampleTime = timeline.getCurrentTimeMillis();
+	//with lookahead the timeline is sampled ahead and the bundle is time tagged
+	//for when it should take effect, so the receiver can absorb network jitter
+	unsigned long lookahead = settings.oscLookahead > 0 ? settings.oscLookahead : 0;
+	unsigned long long timetag = 1; //immediately
+	if(lookahead > 0){
+		timetag = DurationOscWriter::getTimetag(lookahead * 1000);
+		if(timeline.getIsPlaying()){
+			timelineSampleTime = getLookaheadTime(timelineSampleTime, lookahead);
+		}
+	}
 	int numMessages = 0;
-	ofxOscBundle bundle;
+	oscWriter.clear();
+	oscWriter.beginBundle(timetag);
 
-	//lock();
-	vector<ofxTLPage*>& pages = timeline.getPages();
-	for(int i = 0; i < pages.size(); i++){
-		vector<ofxTLTrack*>& tracks = pages[i]->getTracks();
-		for(int t = 0; t < tracks.size(); t++){
-			ofPtr<ofxTLUIHeader> header = headers[tracks[t]->getName()];
-			if(!header->sendOSC()){
-				continue;
+	if(oscIndexDirty){
+		rebuildOscIndex();
+	}
+
+	//a refresh goes out for every track right away, whatever its rate
+	if(refreshAllOscOut){
+		for(int i = 0; i < outputDescriptors.size(); i++){
+			outputDescriptors[i].forceSend = true;
+			outputDescriptors[i].nextSendTime = bundleTime;
+		}
+		refreshAllOscOut = false;
+	}
+
+	//an edit only re-bakes the tracks it changed, between the keys around it
+	if(curvesChanged.exchange(false)){
+		for(int i = 0; i < outputDescriptors.size(); i++){
+			if(outputDescriptors[i].bake != NULL){
+				outputDescriptors[i].bake->refresh();
 			}
-			unsigned long trackSampleTime = tracks[t]->getIsPlaying() ? tracks[t]->currentTrackTime() : timelineSampleTime;
-			string trackType = tracks[t]->getTrackType();
-			if(trackType == "Curves" || trackType == "Switches" || trackType == "Colors" || trackType == "Audio" || trackType == "LFO"){
-				bool messageValid = false;
-				ofxOscMessage m;
-				if(trackType == "Curves" || trackType == "LFO"){
-					ofxTLKeyframes* curves = (ofxTLKeyframes*)tracks[t];
-					float value = curves->getValueAtTimeInMillis(trackSampleTime);
-					if(value != header->lastFloatSent || !header->hasSentValue || refreshAllOscOut){
-						m.addFloatArg(value);
-						header->lastFloatSent = value;
-						header->hasSentValue = true;
-						messageValid = true;
-					}
+		}
+	}
+	bakeBudget = 1024;
+
+	//baked curves on the project rate are all read in one pass
+	batchBakes.clear();
+	unsigned long duration = timeline.getDurationInMillis();
+	for(int i = 0; i < outputDescriptors.size(); i++){
+		DurationOutputDescriptor& output = outputDescriptors[i];
+		output.batchColumn = -1;
+		if(settings.oscBakeCurves && output.bake != NULL && output.header->getOutputRate() <= 0 &&
+		   output.bake->isSetup(oscFrequency, duration) && output.bake->isComplete())
+		{
+			output.batchColumn = batchBakes.size();
+			batchBakes.push_back(output.bake.get());
+		}
+	}
+	if(curveBatch.setup(batchBakes) && batchBakes.size() > 0){
+		float liveDifference, batchMicros, liveMicros;
+		float difference = curveBatch.compare(timelineSampleTime, liveDifference, batchMicros, liveMicros);
+		ofLogVerbose("DurationController") << "Reading " << batchBakes.size() << " baked curves in one pass, " << batchMicros << " us against " << liveMicros
+			<< " us live, vector and scalar differ by " << difference << ", baked and live by " << liveDifference;
+	}
+	batchValues.resize(batchBakes.size());
+	if(batchBakes.size() > 0){
+		curveBatch.evaluate(timelineSampleTime, &batchValues[0]);
+	}
+
+	//each track is sent on its own deadline, tracks that fall due together share
+	//this bundle. the project rate still brings us back for bangs
+	double nextDeadline = bundleTime + oscFrequency;
+	for(int i = 0; i < outputDescriptors.size(); i++){
+		DurationOutputDescriptor& output = outputDescriptors[i];
+		if(!output.header->sendOSC()){
+			continue;
+		}
+		//a track still waiting for its keys is left until the main thread has read them.
+		//colors, switches and LFOs can't be read off the main thread at all
+		if(output.header->keysDeferred){
+			deferredTracksWanted = true;
+			continue;
+		}
+		if(bundleTime < output.nextSendTime){
+			nextDeadline = MIN(nextDeadline, output.nextSendTime);
+			continue;
+		}
+		float rate = output.header->getOutputRate();
+		double period = rate > 0 ? 1000. / rate : oscFrequency;
+		//stay on the track's own schedule unless we fell a whole period behind
+		output.nextSendTime += period;
+		if(output.nextSendTime <= bundleTime){
+			output.nextSendTime = bundleTime + period;
+		}
+		nextDeadline = MIN(nextDeadline, output.nextSendTime);
+
+		bool onChangeOnly = output.header->getSendOnChange() && !output.forceSend;
+		output.forceSend = false;
+
+		unsigned long trackSampleTime = output.track->getIsPlaying() ? output.track->currentTrackTime() + lookahead : timelineSampleTime;
+		switch(output.type){
+			case DURATION_OUTPUT_CURVES:{
+				ofxTLKeyframes* curves = (ofxTLKeyframes*)output.track;
+				ofxTLUIHeader* header = output.header.get();
+				float value = output.batchColumn >= 0 && trackSampleTime == timelineSampleTime ?
+					batchValues[output.batchColumn] : sampleCurve(output, period, trackSampleTime);
+				float span = curves->getValueRange().span();
+
+				//once the curve stops moving the exact value goes out, while it
+				//moves it may be quantized and changes inside the deadband are dropped
+				bool settled = value == output.lastFloatSampled;
+				output.lastFloatSampled = value;
+				float outValue = value;
+				if(!settled && header->getOutputQuantizeSteps() > 0 && span > 0){
+					float step = span / header->getOutputQuantizeSteps();
+					outValue = curves->getValueRange().min + roundf((value - curves->getValueRange().min) / step) * step;
 				}
-				else if(trackType == "Switches"){
-					ofxTLSwitches* switches = (ofxTLSwitches*)tracks[t];
-					bool on = switches->isOnAtMillis(trackSampleTime);
-					if(on != header->lastBoolSent || !header->hasSentValue || refreshAllOscOut){
-						m.addIntArg(on ? 1 : 0);
-						header->lastBoolSent = on;
-						header->hasSentValue = true;
-						messageValid = true;
-					}
+				float deadband = header->getOutputDeadbandRelative() ? header->getOutputDeadband() * span : header->getOutputDeadband();
+				bool changed = settled || deadband <= 0 ? outValue != output.lastFloatSent : fabs(outValue - output.lastFloatSent) > deadband;
+				bool refresh = header->getOutputRefreshSeconds() > 0 && bundleTime - output.lastSentTime >= header->getOutputRefreshSeconds() * 1000;
+
+				if(changed || refresh || !output.hasSentValue || !onChangeOnly){
+					oscWriter.beginMessage(output.prefix);
+					oscWriter.addFloat(outValue);
+					oscWriter.endMessage();
+					output.lastFloatSent = outValue;
+					output.lastSentTime = bundleTime;
+					output.hasSentValue = true;
+					numMessages++;
+					curveValuesSent++;
 				}
-				else if(trackType == "Colors"){
-					ofxTLColorTrack* colors = (ofxTLColorTrack*)tracks[t];
-					ofColor color = colors->getColorAtMillis(trackSampleTime);
-					if(color != header->lastColorSent || !header->hasSentValue || refreshAllOscOut){
-						m.addIntArg(color.r);
-						m.addIntArg(color.g);
-						m.addIntArg(color.b);
-						header->lastColorSent = color;
-						header->hasSentValue = true;
-						messageValid = true;
-					}
+				else if(value != output.lastFloatSent){
+					curveValuesSuppressed++;
 				}
-				else if(trackType == "Audio"){
-					ofxTLAudioTrack* audio = (ofxTLAudioTrack*)tracks[t];
-					if(audio->getIsPlaying() || timeline.getIsPlaying()){
-						vector<float>& bins = audio->getFFT();
-						for(int b = 0; b < bins.size(); b++){
-							m.addFloatArg(bins[b]);
-						}
-						messageValid = true;
-					}
+				break;
+			}
+			case DURATION_OUTPUT_SWITCHES:{
+				bool on = ((ofxTLSwitches*)output.track)->isOnAtMillis(trackSampleTime);
+				if(on != output.lastBoolSent || !output.hasSentValue || !onChangeOnly){
+					oscWriter.beginMessage(output.prefix);
+					oscWriter.addInt(on ? 1 : 0);
+					oscWriter.endMessage();
+					output.lastBoolSent = on;
+					output.hasSentValue = true;
+					numMessages++;
+				}
+				break;
+			}
+			case DURATION_OUTPUT_COLORS:{
+				ofColor color = ((ofxTLColorTrack*)output.track)->getColorAtMillis(trackSampleTime);
+				if(color != output.lastColorSent || !output.hasSentValue || !onChangeOnly){
+					oscWriter.beginMessage(output.prefix);
+					oscWriter.addInt(color.r);
+					oscWriter.addInt(color.g);
+					oscWriter.addInt(color.b);
+					oscWriter.endMessage();
+					output.lastColorSent = color;
+					output.hasSentValue = true;
+					numMessages++;
 				}
-				if(messageValid){
-					m.setAddress(ofFilePath::addLeadingSlash(tracks[t]->getDisplayName()));
-					bundle.addMessage(m);
+				break;
+			}
+			case DURATION_OUTPUT_AUDIO:{
+				ofxTLAudioTrack* audio = (ofxTLAudioTrack*)output.track;
+				if(audio->getIsPlaying() || timeline.getIsPlaying()){
+					vector<float>& bins = audio->getFFT();
+					if(output.prefixArgs != (int)bins.size()){
+						DurationOscWriter::buildPrefix(output.address, "," + string(bins.size(), 'f'), output.prefix);
+						output.prefixArgs = bins.size();
+					}
+					oscWriter.beginMessage(output.prefix);
+					for(int b = 0; b < bins.size(); b++){
+						oscWriter.addFloat(bins[b]);
+					}
+					oscWriter.endMessage();
 					numMessages++;
 				}
+				break;
 			}
 		}
 	}
-	//unlock();
 
-	//any bangs that came our way this frame send them out too
-	for(int i = 0; i < bangsReceived.size(); i++){
-//		cout << "FOUND BANGS!" << endl;
-		bundle.addMessage(bangsReceived[i]);
+	//spot check one baked curve per bundle against the track, in case an edit went unreported
+	if(settings.oscBakeCurves && outputDescriptors.size() > 0){
+		nextBakeCheck = (nextBakeCheck + 1) % outputDescriptors.size();
+		DurationOutputDescriptor& output = outputDescriptors[nextBakeCheck];
+		if(output.bake != NULL && !output.bake->verify(timelineSampleTime)){
+			ofLogVerbose("DurationController") << "Baked curve " << output.address << " no longer matched its track, baking it again";
+		}
+	}
+
+	//any bangs that came our way this frame send them out too. bangs fire at the current
+	//time rather than the sampled one, so with lookahead they go out in their own
+	//immediate bundle to line up with the scheduled values
+	bool bangsWithFrame = timetag == 1;
+	if(bangsWithFrame){
+		for(int i = 0; i < bangsReceived.size(); i++){
+			oscWriter.addMessage(bangsReceived[i]);
+		}
+		numMessages += bangsReceived.size();
 	}
-	numMessages += bangsReceived.size();
 	if(numMessages > 0){
-		sender.sendBundle(bundle);
-		refreshAllOscOut = false;
-
+		sender.sendFrame(oscWriter);
+	}
+	if(!bangsWithFrame && bangsReceived.size() > 0){
+		oscWriter.clear();
+		oscWriter.beginBundle();
+		for(int i = 0; i < bangsReceived.size(); i++){
+			oscWriter.addMessage(bangsReceived[i]);
+		}
+		sender.sendFrame(oscWriter);
+	}
+	//the buffer should settle at the largest frame, report if it keeps growing
+	if(oscWriter.getNumGrowths() != oscWriterGrowths){
+		oscWriterGrowths = oscWriter.getNumGrowths();
+		ofLogVerbose("DurationController") << "OSC output buffer grew to fit a " << oscWriter.getSize() << " byte bundle, " << oscWriterGrowths << " allocations so far";
 	}
 	lastOSCBundleSent = bundleTime;
+	nextOSCBundleTime = ceil(nextDeadline);
 	bangsReceived.clear();
 }
 
+//the top bar address is always the first destination, the rest come from the project file.
+//call with oscLock held
+void DurationController::setupSender(){
+	vector<DurationOscDestination> destinations;
+	DurationOscDestination primary;
+	primary.host = settings.oscIP;
+	primary.port = settings.oscOutPort;
+	primary.enabled = true;
+	destinations.push_back(primary);
+	destinations.insert(destinations.end(), settings.oscDestinations.begin(), settings.oscDestinations.end());
+	sender.setMulticast(settings.oscMulticast, settings.oscMulticastTTL, settings.oscMulticastInterface);
+	sender.setup(destinations);
+}
+
+//playhead position lookahead millis from now, wrapping at the out point when looping
+unsigned long DurationController::getLookaheadTime(unsigned long millis, unsigned long lookahead){
+	unsigned long duration = timeline.getDurationInMillis();
+	unsigned long inTime = timeline.getInOutRange().min * duration;
+	unsigned long outTime = timeline.getInOutRange().max * duration;
+	unsigned long ahead = millis + lookahead;
+	if(ahead > outTime){
+		if(timeline.getLoopType() == OF_LOOP_NORMAL && outTime > inTime){
+			ahead = inTime + (ahead - outTime) % (outTime - inTime);
+		}
+		else{
+			ahead = outTime;
+		}
+	}
+	return ahead;
+}
+
+//reads a curve from its baked samples when they are ready, from the keyframes through its cursor otherwise
+float DurationController::sampleCurve(DurationOutputDescriptor& output, float period, unsigned long millis){
+	ofxTLKeyframes* curves = (ofxTLKeyframes*)output.track;
+	unsigned long duration = timeline.getDurationInMillis();
+	if(!settings.oscBakeCurves){
+		return output.cursor.getValueAtTimeInMillis(millis, duration);
+	}
+
+	if(output.bake == NULL){
+		output.bake = ofPtr<DurationCurveBake>(new DurationCurveBake());
+	}
+	if(!output.bake->isSetup(period, duration)){
+		output.bake->setup(curves, period, duration);
+	}
+	if(bakeBudget > 0 && !output.bake->isComplete()){
+		bakeBudget -= output.bake->update(millis, bakeBudget);
+		if(output.bake->isComplete()){
+			float bakedMicros, liveMicros;
+			float maxError = output.bake->compare(256, bakedMicros, liveMicros);
+			ofLogVerbose("DurationController") << "Baked " << output.address << " into " << output.bake->getNumSamples() << " samples, "
+				<< bakedMicros << " us per read against " << liveMicros << " us live, largest difference " << maxError;
+		}
+	}
+
+	float value;
+	if(output.bake->getValue(millis, value)){
+		return value;
+	}
+	return output.cursor.getValueAtTimeInMillis(millis, duration);
+}
+
 //TODO: hook up to record button
 //and make NO LOOP
 void DurationController::startRecording(){
@@ -1249,1525 +1798,25 @@ void DurationController::bangFired(ofxTLBangEventArgs& bang){
 void DurationController::guiEvent(ofxUIEventArgs &e){
     string name = e.widget->getName();
 	int kind = e.widget->getKind();
-
-    if(name == "active quad")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/set");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "v on/off")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/video/show");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "v load")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/video/load");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "v x scale")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/video/mult/x");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "v y scale")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/video/mult/y");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "v fit")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/video/fit");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "v keep aspect")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/video/keepaspect");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "v hflip")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/video/hmirror");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "v vflip")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/video/vmirror");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "v red")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/video/color/1");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "v green")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/video/color/2");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "v blue")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/video/color/3");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "v alpha")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/video/color/4");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "audio")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/video/volume");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "speed")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/video/speed");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "v loop")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/video/loop");
-    m.addFloatArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "v greenscreen")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/video/greenscreen");
-    m.addFloatArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-        //greenscreen
-
-    if(name == "threshold")
-    {
-    ofxUICircleSlider *csliderValue = (ofxUICircleSlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/greenscreen/threshold");
-    m.addFloatArg(csliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "gs red")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/greenscreen/color/1");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "gs green")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/greenscreen/color/2");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "gs blue")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/greenscreen/color/3");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "gs alpha")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/greenscreen/color/4");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-
-    //Kinect
-    if(name == "k on/off")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/kinect/show");
-    m.addFloatArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "k close/open")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/kinect/close");
-    m.addFloatArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "k show img")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/kinect/show/image");
-    m.addFloatArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "k grayscale")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/kinect/show/grayscale");
-    m.addFloatArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "k mask")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/kinect/mask");
-    m.addFloatArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "k detect")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/kinect/contour");
-    m.addFloatArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "k scale x")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/kinect/mult/x");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "k scale y")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/kinect/mult/y");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "k threshold near")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/kinect/threshold/near");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "k threshold far")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/kinect/threshold/far");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "k angle")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/kinect/angle");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "k blur")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/kinect/blur");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "k smooth")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/kinect/contour/smooth");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "k simplify")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/kinect/contour/simplify");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "k min blob")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/kinect/contour/area/min");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "k max blob")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/kinect/contour/area/max");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "k red")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/kinect/color/1");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "k green")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/kinect/color/2");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "k blue")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/kinect/color/3");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "k alpha")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/kinect/color/4");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-
-
-
-
-    //slideshow
-    if(name == "sh on/off")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/slideshow/show");
-    m.addFloatArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "sh load")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/slideshow/folder");
-    m.addFloatArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-
-    if(name == "sh fit")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/slideshow/fit");
-    m.addFloatArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "sh aspect ratio")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/slideshow/keep_aspect");
-    m.addFloatArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "sh greenscreen")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/slideshow/greenscreen");
-    m.addFloatArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-
-
-    if(name == "sh duration")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/slideshow/duration");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-/*    if(name == "show/hide")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/show");
-    m.addFloatArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-*/
-    //timeline
-
-    if(name == "use timeline")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/projection/timeline/toggle");
-    m.addFloatArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "seconds")
-    {
-    ofxUIMinimalSlider *sliderValue = (ofxUIMinimalSlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/projection/timeline/duration");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "tl tint")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/timeline/tint");
-    m.addFloatArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "tl color")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/timeline/color");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "tl alpha")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/timeline/alpha");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "tl 4 slides")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/timeline/slides");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-
-    //camera
-
-    if(name == "c on/off")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/cam/show");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "c load")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/cam/show");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "c scale x")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/cam/mult/x");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "c scale y")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/cam/mult/y");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "c fit")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/cam/fit");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "c aspect ratio")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/cam/keepaspect");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "c hflip")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/cam/hmirror");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "c vflip")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/cam/vmirror");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "c red")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/cam/color/1");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "c green")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/cam/color/2");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "c blue")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/cam/color/3");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "c alpha")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/cam/color/4");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "cam audio")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/cam/volume");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "c greenscreen")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/cam/greenscreen");
-    m.addFloatArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "camera 0")
-    {
-    ofxUIDropDownList *ddl = (ofxUIDropDownList *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/cam/num");
-    m.addIntArg(0);
-    //m.addIntArg(1);
-    //m.addIntArg(3);
-    //m.addIntArg(4);
-    m.addIntArg(ddl->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "camera 1")
-    {
-    ofxUIDropDownList *ddl = (ofxUIDropDownList *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/cam/num");
-    m.addIntArg(1);
-    //m.addIntArg(1);
-    //m.addIntArg(3);
-    //m.addIntArg(4);
-    m.addIntArg(ddl->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "camera 2")
-    {
-    ofxUIDropDownList *ddl = (ofxUIDropDownList *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/cam/num");
-    m.addIntArg(2);
-    //m.addIntArg(1);
-    //m.addIntArg(3);
-    //m.addIntArg(4);
-    m.addIntArg(ddl->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "camera 3")
-    {
-    ofxUIDropDownList *ddl = (ofxUIDropDownList *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/cam/num");
-    m.addIntArg(3);
-    //m.addIntArg(1);
-    //m.addIntArg(3);
-    //m.addIntArg(4);
-    m.addIntArg(ddl->getValue());
-    sender.sendMessage(m);
-    }
-
-
-    //image
-
-    if(name == "i on/off")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/img/show");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "i load")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/img/load");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "i fit")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/img/fit");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "i aspect ratio")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/img/keepaspect");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "i scale x")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/img/mult/x");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "i scale y")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/img/mult/y");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "i hflip")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/img/hmirror");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "i vflip")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/img/vmirror");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "i greenscreen")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/img/greenscreen");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "i red")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/img/color/1");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "i green")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/img/color/2");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "i blue")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/img/color/3");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "i alpha")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/img/color/4");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-
-    //placement
-    if(name == "move x")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/placement/x");
-    m.addIntArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-     if(name == "move y")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/placement/y");
-    m.addIntArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "width")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/placement/w");
-    m.addIntArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "height")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/placement/h");
-    m.addIntArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "reset")
-    {
-    ofxUIButton *button = (ofxUIButton *) e.getButton();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/placement/reset");
-    m.addIntArg(button->getValue());
-    sender.sendMessage(m);
-    }
-
-    //edge blend
-
-    if(name == "eb on/off")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/edgeblend/show");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-     if(name == "power")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/edgeblend/power");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "gamma")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/edgeblend/gamma");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "luminance")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/edgeblend/luminance");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "left edge")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/edgeblend/amount/left");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "right edge")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/edgeblend/amount/right");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "top edge")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/edgeblend/amount/top");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "bottom edge")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/edgeblend/amount/bottom");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-
-     //blend modes
-
-     if(name == "bm on/off")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/blendmodes/show");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-     if(name == "screen")
-    {
-    ofxUIDropDownList *ddl = (ofxUIDropDownList *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/blendmodes/mode");
-    m.addIntArg(0);
-    //m.addIntArg(1);
-    //m.addIntArg(3);
-    //m.addIntArg(4);
-    m.addIntArg(ddl->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "add")
-    {
-    ofxUIDropDownList *ddl = (ofxUIDropDownList *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/blendmodes/mode");
-    m.addIntArg(1);
-    //m.addIntArg(1);
-    //m.addIntArg(3);
-    //m.addIntArg(4);
-    m.addIntArg(ddl->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "subtract")
-    {
-    ofxUIDropDownList *ddl = (ofxUIDropDownList *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/blendmodes/mode");
-    m.addIntArg(2);
-    //m.addIntArg(1);
-    //m.addIntArg(3);
-    //m.addIntArg(4);
-    m.addIntArg(ddl->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "multiply")
-    {
-    ofxUIDropDownList *ddl = (ofxUIDropDownList *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/blendmodes/mode");
-    m.addIntArg(3);
-    //m.addIntArg(1);
-    //m.addIntArg(3);
-    //m.addIntArg(4);
-    m.addIntArg(ddl->getValue());
-    sender.sendMessage(m);
-    }
-
-    //solid color
-
-    if(name == "sc on/off")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/solid/show");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "sc red")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/solid/color/1");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "sc green")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/solid/color/2");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "sc blue")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/solid/color/3");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "sc alpha")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/solid/color/4");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-
-    //Projection
-
-    if(name == "live resync")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/projection/resync");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "live stop/start")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/projection/stop");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "direct save")
-    {
-    ofxUIButton *button = (ofxUIButton *) e.getButton();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/projection/save");
-    m.addIntArg(button->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "direct load")
-    {
-    ofxUIButton *button = (ofxUIButton *) e.getButton();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/projection/load");
-    m.addIntArg(button->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "load file")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/projection/loadfile");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "save file")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/projection/savefile");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "live fc on/off")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/projection/fullscreen/toggle");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "display gui")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/projection/gui/toggle");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-
-/*    if(name == "modesetup on/off")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/projection/mode/setup/toggle");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-*/
-    //mask
-
-    if(name == "m on/off")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/mask/show");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "m invert")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/mask/invert");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "mask edit on/off")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/projection/mode/masksetup/toggle");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-
-    //Deform
-    if(name == "d on/off")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/deform/show");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "bezier")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/deform/bezier");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "spherize light")
-    {
-    ofxUIButton *button = (ofxUIButton *) e.getButton();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/deform/bezier/spherize/light");
-    m.addIntArg(button->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "spherize strong")
-    {
-    ofxUIButton *button = (ofxUIButton *) e.getButton();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/deform/bezier/spherize/strong");
-    m.addIntArg(button->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "bezier reset")
-    {
-    ofxUIButton *button = (ofxUIButton *) e.getButton();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/deform/bezier/reset");
-    m.addIntArg(button->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "grid")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/deform/grid");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "rows num")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/deform/grid/rows");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "columns num")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/deform/grid/columns");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "edit")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/deform/edit");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-
-    //crop
-
-    if(name == "top")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/crop/rectangular/top");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "right")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/crop/rectangular/right");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "left")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/crop/rectangular/left");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "bottom")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/crop/rectangular/bottom");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "x")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/crop/circular/x");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "y")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/crop/circular/y");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "radius")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/crop/circular/radius");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    //active surface
-    if(name == "Number")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/set");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    //transition
-    if(name == "tr on/off")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/solid/trans/show");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "tr red")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/solid/trans/color/1");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "tr green")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/solid/trans/color/2");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "tr blue")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/solid/trans/color/3");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "tr alpha")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/solid/trans/color/4");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "tr duration")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/solid/trans/duration");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    //3d model
-    if(name == "3d load")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/3d/load");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "3d scale x")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/3d/scale/x");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "3d scale y")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/3d/scale/y");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "3d scale z")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/3d/scale/z");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "3d rotate x")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/3d/rotate/x");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "3d rotate y")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/3d/rotate/y");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "3d rotate z")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/3d/rotate/z");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "3d move x")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/3d/move/x");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "3d move y")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/3d/move/y");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "3d move z")
-    {
-    ofxUISlider *sliderValue = (ofxUISlider *) e.getSlider();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/3d/move/z");
-    m.addFloatArg(sliderValue->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "animation")
-    {
-    ofxUIToggle *toggle = (ofxUIToggle *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/3d/animation");
-    m.addIntArg(toggle->getValue());
-    sender.sendMessage(m);
-    }
-        if(name == "smooth")
-    {
-    ofxUIDropDownList *ddl = (ofxUIDropDownList *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/3d/texture/mode");
-    m.addIntArg(0);
-    m.addIntArg(ddl->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "wire")
-    {
-    ofxUIDropDownList *ddl = (ofxUIDropDownList *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/3d/texture/mode");
-    m.addIntArg(1);
-    m.addIntArg(ddl->getValue());
-    sender.sendMessage(m);
-    }
-    if(name == "dots")
-    {
-    ofxUIDropDownList *ddl = (ofxUIDropDownList *) e.getToggle();
-    cout << "got event from: " << name << endl;
-    ofxOscMessage m;
-    m.setAddress("/active/3d/texture/mode");
-    m.addIntArg(2);
-    m.addIntArg(ddl->getValue());
-    sender.sendMessage(m);
-    }
-
-
-
-
-	//	cout << "name is " << name << " kind is " << kind << endl;
-
-	if(e.widget == stopButton && stopButton->getValue()){
-		if(timeline.getIsPlaying()){
-	        timeline.stop();
-		}
-		else{
-	        timeline.setCurrentTimeMillis(0);
-		}
+
+	//remote panel widgets are looked up in the parameter table and sent from the OSC thread
+	ofxOscMessage remoteMessage;
+	bool continuous;
+	if(remoteMap.getMessage(e.widget, remoteMessage, continuous)){
+		controlQueue.add(remoteMessage, continuous);
+		oscWakeup.notify();
+		return;
+	}
+
+	//	cout << "name is " << name << " kind is " << kind << endl;
+
+	if(e.widget == stopButton && stopButton->getValue()){
+		if(timeline.getIsPlaying()){
+	        timeline.stop();
+		}
+		else{
+	        timeline.setCurrentTimeMillis(0);
+		}
     }
     else if(name == "PLAYPAUSE"){
 		if(!timeline.getIsPlaying()){
@@ -2886,12 +1935,26 @@ void DurationController::guiEvent(ofxUIEventArgs &e){
 		settings.oscOutEnabled = enableOSCOutToggle->getValue();
         if(settings.oscOutEnabled){
 			oscLock.lock();
-            sender.setup(settings.oscIP, settings.oscOutPort);
+            setupSender();
 			oscLock.unlock();
 			needsSave = true;
         }
+		oscWakeup.notify();
     }
 
+	//MULTICAST
+	else if(e.widget == multicastToggle){
+		settings.oscMulticast = multicastToggle->getValue();
+		int firstOctet = ofToInt(settings.oscIP);
+		if(settings.oscMulticast && (firstOctet < 224 || firstOctet > 239)){
+			ofLogWarning("DurationController") << settings.oscIP << " is not a multicast group, enter one between 224.0.0.0 and 239.255.255.255";
+		}
+		oscLock.lock();
+		setupSender();
+		oscLock.unlock();
+		needsSave = true;
+	}
+
 	//OUTGOING IP
     else if(e.widget == oscOutIPInput && !gui->hasKeyboardFocus()){
         string newIP = ofToLower(oscOutIPInput->getTextString());
@@ -2922,7 +1985,7 @@ void DurationController::guiEvent(ofxUIEventArgs &e){
 		if(valid){
 			settings.oscIP = newIP;
 			oscLock.lock();
-			sender.setup(settings.oscIP, settings.oscOutPort);
+			setupSender();
 			oscLock.unlock();
 			needsSave = true;
 		}
@@ -2937,7 +2000,7 @@ void DurationController::guiEvent(ofxUIEventArgs &e){
 		   (newPort != settings.oscInPort || (settings.oscIP != "localhost" && settings.oscIP != "127.0.0.1"))){
             settings.oscOutPort = newPort;
 			oscLock.lock();
-			sender.setup(settings.oscIP, settings.oscOutPort);
+			setupSender();
 			oscLock.unlock();
 			needsSave = true;
         }
@@ -2948,7 +2011,7 @@ void DurationController::guiEvent(ofxUIEventArgs &e){
 }
 
 //--------------------------------------------------------------
-ofxTLTrack* DurationController::addTrack(string trackType, string trackName, string xmlFileName){
+ofxTLTrack* DurationController::addTrack(string trackType, string trackName, string xmlFileName, bool readKeys){
 	ofxTLTrack* newTrack = NULL;
 
 	trackType = ofToLower(trackType);
@@ -2960,24 +2023,27 @@ ofxTLTrack* DurationController::addTrack(string trackType, string trackName, str
 		string uniqueName = timeline.confirmedUniqueName(trackName);
 		xmlFileName = ofToDataPath(settings.path + "/" + uniqueName + "_.xml");
 	}
+	//the timeline reads a track's file as it adds it. a path under the track's own file
+	//can't exist, so there is nothing to read there
+	string addedFileName = readKeys ? xmlFileName : xmlFileName + "/unread";
 
 	if(trackType == translation.translateKey("bangs") || trackType == "bangs"){
-		newTrack = timeline.addBangs(trackName, xmlFileName);
+		newTrack = timeline.addBangs(trackName, addedFileName);
 	}
 	else if(trackType == translation.translateKey("flags") || trackType == "flags"){
-		newTrack = timeline.addFlags(trackName, xmlFileName);
+		newTrack = timeline.addFlags(trackName, addedFileName);
 	}
 	else if(trackType == translation.translateKey("curves") || trackType == "curves"){
-		newTrack = timeline.addCurves(trackName, xmlFileName);
+		newTrack = timeline.addCurves(trackName, addedFileName);
 	}
 	else if(trackType == translation.translateKey("switches")|| trackType == "switches"){
-		newTrack = timeline.addSwitches(trackName, xmlFileName);
+		newTrack = timeline.addSwitches(trackName, addedFileName);
 	}
 	else if(trackType == translation.translateKey("colors") || trackType == "colors"){
-		newTrack = timeline.addColors(trackName, xmlFileName);
+		newTrack = timeline.addColors(trackName, addedFileName);
 	}
 	else if(trackType == translation.translateKey("lfo") || trackType == "lfo"){
-		newTrack = timeline.addLFO(trackName, xmlFileName);
+		newTrack = timeline.addLFO(trackName, addedFileName);
 	}
 	else if(trackType == translation.translateKey("audio") || trackType == "audio"){
 		if(audioTrack != NULL){
@@ -2994,8 +2060,19 @@ ofxTLTrack* DurationController::addTrack(string trackType, string trackName, str
 		ofLogError("DurationController::addTrack") << "Unsupported track type: " << trackType;
 	}
 
+	//whatever the timeline made of the missing file, the track starts with no keys
+	if(newTrack != NULL && !readKeys && newTrack->getTrackType() != "Audio"){
+		vector<ofxTLKeyframe*>& keyframes = DurationKeyframeAccess::getKeyframes((ofxTLKeyframes*)newTrack);
+		for(int i = 0; i < keyframes.size(); i++){
+			delete keyframes[i];
+		}
+		keyframes.clear();
+		newTrack->setXMLFileName(xmlFileName);
+	}
+
 	if(newTrack != NULL){
 		createHeaderForTrack(newTrack);
+		oscIndexDirty = true;
 		needsSave = true;
 	}
 	return newTrack;
@@ -3003,14 +2080,42 @@ ofxTLTrack* DurationController::addTrack(string trackType, string trackName, str
 
 //--------------------------------------------------------------
 void DurationController::update(ofEventArgs& args){
-	gui->update();
+	if(!headless){
+		gui->update();
+	}
+
+	if(projectIndex.hasUpdate()){
+		vector<string> indexedProjects = projectIndex.getProjects();
+		for(int i = 0; i < listedProjects.size(); i++){
+			if(find(indexedProjects.begin(), indexedProjects.end(), listedProjects[i]) != indexedProjects.end()){
+				continue;
+			}
+			//a project made while the scan ran isn't in it yet
+			if(ofFile::doesFileExist(ofFilePath::join(defaultProjectDirectoryPath, listedProjects[i] + "/.durationproj"))){
+				indexedProjects.push_back(listedProjects[i]);
+			}
+			else{
+				projectDropDown->removeToggle(listedProjects[i]);
+			}
+		}
+		for(int i = 0; i < indexedProjects.size(); i++){
+			if(find(listedProjects.begin(), listedProjects.end(), indexedProjects[i]) == listedProjects.end()){
+				projectDropDown->addToggle(indexedProjects[i]);
+			}
+		}
+		listedProjects = indexedProjects;
+	}
 
 	if(shouldStartPlayback){
 		shouldStartPlayback = false;
 		startPlayback();
 	}
-	timeLabel->setLabel(timeline.getCurrentTimecode());
-	playpauseToggle->setValue(timeline.getIsPlaying());
+	if(timeline.getUserChangedValue()){
+		curvesChanged = true;
+		needsSave = true;
+		journalEditPending = true;
+		lastJournalEdit = ofGetElapsedTimef();
+	}
 
 	if(audioTrack != NULL && audioTrack->isSoundLoaded()){
 
@@ -3022,13 +2127,17 @@ void DurationController::update(ofEventArgs& args){
 			timeline.setDurationInSeconds(audioTrack->getDuration());
 		}
 
-		if(durationLabel->getTextString() != timeline.getDurationInTimecode()){
+		if(!headless && durationLabel->getTextString() != timeline.getDurationInTimecode()){
 			durationLabel->setTextString(timeline.getDurationInTimecode());
 		}
 	}
 
-	if(ofGetHeight() < timeline.getDrawRect().getMaxY()){
-		ofSetWindowShape(ofGetWidth(), timeline.getDrawRect().getMaxY()+30);
+	if(!headless){
+		timeLabel->setLabel(timeline.getCurrentTimecode());
+		playpauseToggle->setValue(timeline.getIsPlaying());
+		if(ofGetHeight() < timeline.getDrawRect().getMaxY()){
+			ofSetWindowShape(ofGetWidth(), timeline.getDrawRect().getMaxY()+30);
+		}
 	}
     if(shouldLoadProject){
         shouldLoadProject = false;
@@ -3058,9 +2167,18 @@ void DurationController::update(ofEventArgs& args){
 		}
     }
 
+	if(shouldSaveProject){
+		shouldSaveProject = false;
+		saveProject();
+	}
+
 	if(receivedPaletteToLoad){
 		receivedPaletteToLoad = false;
-		if(!paletteTrack->loadColorPalette(palettePath)){
+		//a palette is an image with a texture, which needs a window
+		if(headless){
+			ofLogWarning("Duration:OSC") << "Color palettes can't be loaded when running headless, ignoring " << palettePath;
+		}
+		else if(!paletteTrack->loadColorPalette(palettePath)){
 			ofLogError("Duration:OSC") << "Set color palette failed, file not found";
 		}
 	}
@@ -3072,16 +2190,27 @@ void DurationController::update(ofEventArgs& args){
 		unlock();
 	}
 
+	//display names are edited in place in the track headers, which hold the timeline
+	//modal while the name field is open, so names are only compared once it closes
+	bool timelineModal = timeline.isModal();
+	if(timelineWasModal && !timelineModal){
+		checkDisplayNames();
+	}
+	timelineWasModal = timelineModal;
+
     //check if we deleted an element this frame
     map<string,ofPtr<ofxTLUIHeader> >::iterator it = headers.begin();
     while(it != headers.end()){
 
-		needsSave |= it->second->getModified();
+		if(it->second->getModified()){
+			needsSave = true;
+			curvesChanged = true;
+		}
 
-		if(timeline.isModal() && it->second->getGui()->isEnabled()){
+		if(it->second->hasGui() && timeline.isModal() && it->second->getGui()->isEnabled()){
 			it->second->getGui()->disable();
 		}
-		else if(!timeline.isModal() && !it->second->getGui()->isEnabled()){
+		else if(it->second->hasGui() && !timeline.isModal() && !it->second->getGui()->isEnabled()){
 			it->second->getGui()->enable();
 		}
 
@@ -3098,13 +2227,89 @@ void DurationController::update(ofEventArgs& args){
 					audioTrack = NULL;
 				}
 			}
+            indexedDisplayNames.erase(it->first);
             headers.erase(it);
+			oscIndexDirty = true;
 			unlock();
 			needsSave = true;
             break;
         }
         it++;
     }
+
+	//the page being viewed gets its keys and header controls before it is drawn and
+	//the rest stream in a track a frame. bangs fire from any page, so playback
+	//takes them all, with the timeline off its thread while they are read, and so
+	//does OSC that met a track not read yet
+	ofxTLPage* currentPage = NULL;
+	vector<ofxTLPage*>& pages = timeline.getPages();
+	for(int i = 0; i < pages.size(); i++){
+		if(pages[i]->getName() == timeline.getCurrentPageName()){
+			currentPage = pages[i];
+		}
+	}
+	bool tracksWanted = deferredTracksWanted.exchange(false);
+	if(hasDeferredTracks()){
+		if(timeline.getIsPlaying() || tracksWanted){
+			lock();
+			timeline.removeFromThread();
+			loadDeferredTracks(NULL, -1);
+			timeline.moveToThread();
+			unlock();
+		}
+		else if(currentPage == NULL || loadDeferredTracks(currentPage, -1) == 0){
+			loadDeferredTracks(NULL, 1);
+		}
+	}
+	noteLoadedTracks();
+	if(!headless && currentPage != NULL){
+		vector<ofxTLTrack*>& tracks = currentPage->getTracks();
+		for(int i = 0; i < tracks.size(); i++){
+			map<string,ofPtr<ofxTLUIHeader> >::iterator header = headers.find(tracks[i]->getName());
+			if(header != headers.end() && !header->second->hasGui()){
+				header->second->createGui();
+			}
+		}
+	}
+
+	//a drag is journaled once it settles, and the journal is folded back into the
+	//project when it grows. the save only writes what changed
+	if(journalEditPending && ofGetElapsedTimef() - lastJournalEdit > JOURNAL_SETTLE_SECONDS){
+		journalTracks(true);
+	}
+	journal.flush();
+	if(journal.getSize() > JOURNAL_COMPACT_BYTES && !projectWriter.isSaving()){
+		ofLogNotice("DurationController") << "Saving to fold " << journal.getSize() << " journaled bytes into the project";
+		saveProject();
+	}
+	//the old journal goes once the save it was rotated for, or a later one, is on disk
+	if(journal.hasRotated() && journalSaveGeneration > 0 &&
+	   projectWriter.getLastSaveGeneration() >= journalSaveGeneration && !projectWriter.getLastSaveFailed())
+	{
+		journal.removeRotated();
+		journalSaveGeneration = -1;
+	}
+	//tracks count as saved once the writer is done, if anything failed they are written again
+	if(!savingFingerprints.empty() && !projectWriter.isSaving()){
+		if(!projectWriter.getLastSaveFailed()){
+			for(map<string, unsigned long long>::iterator it = savingFingerprints.begin(); it != savingFingerprints.end(); it++){
+				savedFingerprints[it->first] = it->second;
+			}
+		}
+		savingFingerprints.clear();
+	}
+}
+
+//--------------------------------------------------------------
+void DurationController::checkDisplayNames(){
+	map<string,ofPtr<ofxTLUIHeader> >::iterator it;
+	for(it = headers.begin(); it != headers.end(); it++){
+		string displayName = it->second->getTrack()->getDisplayName();
+		if(indexedDisplayNames[it->first] != displayName){
+			indexedDisplayNames[it->first] = displayName;
+			oscIndexDirty = true;
+		}
+	}
 }
 
 //--------------------------------------------------------------
@@ -3141,14 +2346,30 @@ void DurationController::draw(ofEventArgs& args){
 	timeline.draw();
 	gui->draw();
 
-	if(needsSave || timeline.hasUnsavedChanges()){
-		ofPushStyle();
-		ofSetColor(200,20,0, 40);
-		ofFill();
-		ofxUIRectangle r = *saveButton->getRect();
+	//saves finish in the background, the button shows while one is writing and
+	//flashes once it is on disk, or stays red if it failed
+	if(projectWriter.getNumSaves() != savesShown){
+		savesShown = projectWriter.getNumSaves();
+		saveFinishedTime = ofGetElapsedTimef();
+	}
+	bool saveFailed = projectWriter.getLastSaveFailed();
+	float timeSinceSave = ofGetElapsedTimef() - saveFinishedTime;
+	ofxUIRectangle r = *saveButton->getRect();
+	ofPushStyle();
+	ofFill();
+	if(projectWriter.isSaving()){
+		ofSetColor(200,160,0, 60);
+		ofRect(r.x,r.y,r.width,r.height);
+	}
+	else if(needsSave || saveFailed){
+		ofSetColor(200,20,0, saveFailed ? 120 : 40);
+		ofRect(r.x,r.y,r.width,r.height);
+	}
+	else if(savesShown > 0 && timeSinceSave < 1.0){
+		ofSetColor(20,200,0, (1-timeSinceSave)*80);
 		ofRect(r.x,r.y,r.width,r.height);
-		ofPopStyle();
 	}
+	ofPopStyle();
 	drawTooltips();
 	//drawTooltipDebug();
 
@@ -3211,16 +2432,20 @@ void DurationController::keyPressed(ofKeyEventArgs& keyArgs){
 		//gui->enable();
 		//gui->disableAppEventCallbacks();
 		timeline.show();
-        gui0->setVisible(false);
-        gui1->setVisible(false);
-        gui4->setVisible(false);
-        gui3->setVisible(false);
-        gui2->setVisible(false);
-        gui6->setVisible(false);
-        gui7->setVisible(false);
-        gui8->setVisible(false);
-        gui9->setVisible(false);
-        gui11->setVisible(false);
+        if(remotePanelsCreated[0]){
+            gui0->setVisible(false);
+            gui1->setVisible(false);
+            gui4->setVisible(false);
+            gui3->setVisible(false);
+            gui2->setVisible(false);
+        }
+        if(remotePanelsCreated[1]){
+            gui6->setVisible(false);
+            gui7->setVisible(false);
+            gui8->setVisible(false);
+            gui9->setVisible(false);
+            gui11->setVisible(false);
+        }
 
 		//timeline.enable();
 		/*map<string,ofPtr<ofxTLUIHeader> >::iterator it = headers.begin();
@@ -3238,32 +2463,40 @@ void DurationController::keyPressed(ofKeyEventArgs& keyArgs){
 		//ofRemoveListener(ofEvents().draw, this, &DurationController::draw);
 		//ofRemoveListener(ofEvents().keyPressed, this, &DurationController::keyPressed);
 		timeline.hide();
+		createRemotePanels(0);
 		gui0->setVisible(true);
         gui1->setVisible(true);
         gui4->setVisible(true);
         gui3->setVisible(true);
         gui2->setVisible(true);
-        gui6->setVisible(false);
-        gui7->setVisible(false);
-        gui8->setVisible(false);
-        gui9->setVisible(false);
-        gui11->setVisible(false);
+        if(remotePanelsCreated[1]){
+            gui6->setVisible(false);
+            gui7->setVisible(false);
+            gui8->setVisible(false);
+            gui9->setVisible(false);
+            gui11->setVisible(false);
+        }
 		//gui->disable();
 		//timeline.disable();
 		map<string,ofPtr<ofxTLUIHeader> >::iterator it = headers.begin();
 		while(it != headers.end()){
-			it->second->getGui()->disable();
+			if(it->second->hasGui()){
+				it->second->getGui()->disable();
+			}
 			it++;
         }
     }
     if(key == OF_KEY_F4)
     {
         timeline.hide();
-        gui0->setVisible(false);
-        gui1->setVisible(false);
-        gui4->setVisible(false);
-        gui3->setVisible(false);
-        gui2->setVisible(false);
+        createRemotePanels(1);
+        if(remotePanelsCreated[0]){
+            gui0->setVisible(false);
+            gui1->setVisible(false);
+            gui4->setVisible(false);
+            gui3->setVisible(false);
+            gui2->setVisible(false);
+        }
         gui6->setVisible(true);
         gui7->setVisible(true);
         gui8->setVisible(true);
@@ -3272,20 +2505,26 @@ void DurationController::keyPressed(ofKeyEventArgs& keyArgs){
     }
         if(key == 's')
             {
-            gui0->saveSettings("gui0Settings.xml");
-            gui1->saveSettings("gui1Settings.xml");
-            gui2->saveSettings("gui2Settings.xml");
-            gui3->saveSettings("gui3Settings.xml");
-            gui4->saveSettings("gui4Settings.xml");
-            gui5->saveSettings("gui5Settings.xml");
-            gui6->saveSettings("gui6Settings.xml");
-            gui7->saveSettings("gui7Settings.xml");
-            gui8->saveSettings("gui8Settings.xml");
-            gui9->saveSettings("gui9Settings.xml");
-            gui11->saveSettings("gui11Settings.xml");
+            if(remotePanelsCreated[0]){
+                gui0->saveSettings("gui0Settings.xml");
+                gui1->saveSettings("gui1Settings.xml");
+                gui2->saveSettings("gui2Settings.xml");
+                gui3->saveSettings("gui3Settings.xml");
+                gui4->saveSettings("gui4Settings.xml");
+                gui5->saveSettings("gui5Settings.xml");
+            }
+            if(remotePanelsCreated[1]){
+                gui6->saveSettings("gui6Settings.xml");
+                gui7->saveSettings("gui7Settings.xml");
+                gui8->saveSettings("gui8Settings.xml");
+                gui9->saveSettings("gui9Settings.xml");
+                gui11->saveSettings("gui11Settings.xml");
+            }
             }
         if(key == 'l')
             {
+            createRemotePanels(0);
+            createRemotePanels(1);
             gui0->loadSettings("gui0Settings.xml");
             gui1->loadSettings("gui1Settings.xml");
             gui2->loadSettings("gui2Settings.xml");
@@ -3300,32 +2539,42 @@ void DurationController::keyPressed(ofKeyEventArgs& keyArgs){
             }
         if(key == OF_KEY_F6)
             {
-                gui0->setMinified(true);
-                gui1->setMinified(true);
-                gui2->setMinified(true);
-                gui3->setMinified(true);
-                gui4->setMinified(true);
+                remotePanelsMinified = true;
+                if(remotePanelsCreated[0]){
+                    gui0->setMinified(true);
+                    gui1->setMinified(true);
+                    gui2->setMinified(true);
+                    gui3->setMinified(true);
+                    gui4->setMinified(true);
 //                gui5->setMinified(true);
-                gui6->setMinified(true);
-                gui7->setMinified(true);
-                gui8->setMinified(true);
-                gui9->setMinified(true);
-                gui11->setMinified(true);
+                }
+                if(remotePanelsCreated[1]){
+                    gui6->setMinified(true);
+                    gui7->setMinified(true);
+                    gui8->setMinified(true);
+                    gui9->setMinified(true);
+                    gui11->setMinified(true);
+                }
 
             }
          if(key == OF_KEY_F5)
             {
-                gui0->setMinified(false);
-                gui1->setMinified(false);
-                gui2->setMinified(false);
-                gui3->setMinified(false);
-                gui4->setMinified(false);
+                remotePanelsMinified = false;
+                if(remotePanelsCreated[0]){
+                    gui0->setMinified(false);
+                    gui1->setMinified(false);
+                    gui2->setMinified(false);
+                    gui3->setMinified(false);
+                    gui4->setMinified(false);
 //                gui5->setMinified(false);
-                gui6->setMinified(false);
-                gui7->setMinified(false);
-                gui8->setMinified(false);
-                gui9->setMinified(false);
-                gui11->setMinified(false);
+                }
+                if(remotePanelsCreated[1]){
+                    gui6->setMinified(false);
+                    gui7->setMinified(false);
+                    gui8->setMinified(false);
+                    gui9->setMinified(false);
+                    gui11->setMinified(false);
+                }
             }
             if(key == '~')
             {
@@ -3383,11 +2632,17 @@ DurationProjectSettings DurationController::defaultProjectSettings(){
     settings.snapToKeys = true;
 
 	settings.oscRate = 30;
+	settings.oscLookahead = 0;
+	settings.oscBakeCurves = false;
+	settings.binaryKeyframes = false;
     settings.oscOutEnabled = true;
 	settings.oscInEnabled = true;
     settings.oscInPort = 12346;
     settings.oscIP = "localhost";
     settings.oscOutPort = 12345;
+	settings.oscMulticast = false;
+	settings.oscMulticastTTL = 1;
+	settings.oscMulticastInterface = "";
     return settings;
 }
 
@@ -3414,19 +2669,22 @@ void DurationController::newProject(string newProjectPath, string newProjectName
 #endif
     ofDirectory newProjectDirectory(newProjectSettings.path);
     if(newProjectDirectory.exists()){
-    	ofSystemAlertDialog(translation.translateKey("Error creating new project. The folder already exists.")+" " + newProjectSettings.path);
+    	showError(translation.translateKey("Error creating new project. The folder already exists.")+" " + newProjectSettings.path);
         return;
     }
     if(!newProjectDirectory.create(true)){
-    	ofSystemAlertDialog(translation.translateKey("Error creating new project. The folder could not be created.")+" " + newProjectSettings.path);
+    	showError(translation.translateKey("Error creating new project. The folder could not be created.")+" " + newProjectSettings.path);
         return;
     }
 
     //TODO: prompt to save existing project
+	journal.close();
     settings = newProjectSettings;
 	lock();
+	clearDeferredTracks();
     headers.clear(); //smart pointers will call destructor
     timeline.reset();
+	oscIndexDirty = true;
 	unlock();
 
     //saves file with default settings to new directory
@@ -3434,7 +2692,10 @@ void DurationController::newProject(string newProjectPath, string newProjectName
 
     loadProject(settings.path, settings.name);
 
-    projectDropDown->addToggle(newProjectName);
+	if(!headless){
+		projectDropDown->addToggle(newProjectName);
+	}
+	listedProjects.push_back(newProjectName);
 }
 
 //--------------------------------------------------------------
@@ -3451,6 +2712,12 @@ void DurationController::loadProject(string projectPath, bool forceCreate){
 
 //--------------------------------------------------------------
 void DurationController::loadProject(string projectPath, string projectName, bool forceCreate){
+	//a save still being written could be the very project we are about to read
+	projectWriter.waitForSaves();
+	journal.close();
+
+	//time spent in each phase is logged once the project is open
+	unsigned long long loadStart = ofGetElapsedTimeMillis();
     ofxXmlSettings projectSettings;
 	string projectDataPath = ofToDataPath(projectPath+"/.durationproj");
 	if(!projectSettings.loadFile(projectDataPath)){
@@ -3463,12 +2730,43 @@ void DurationController::loadProject(string projectPath, string projectName, boo
         return;
     }
 
+	//curves and bangs come from the binary store when the project keeps one
+	bool binaryKeyframes = projectSettings.getValue("projectSettings:binaryKeyframes", false);
+	clearDeferredTracks();
+	headlessPalettes.clear();
+	if(binaryKeyframes){
+		keyframeStore.open(projectPath + "/.durationkeys");
+	}
+	int numStoredKeyframes = 0;
+	int numXMLTracks = 0;
+	int numDeferredTracks = 0;
+	DurationKeyframeParser keyframeParser;
+	unsigned long long phaseStart = ofGetElapsedTimeMillis();
+	unsigned long long projectMillis = phaseStart - loadStart;
+
+	//edits journaled after the last save by a session that ended without saving.
+	//a track's last snapshot is read in place of its XML, recorded keys go in after
+	vector<DurationJournalRecord> journalRecords;
+	DurationJournal::read(projectPath, journalRecords);
+	map<string, int> journalSnapshots;
+	set<string> journaledTracks; //replayed right away, so never deferred
+	vector<string> recoveredPaths; //files behind the snapshots, left for the next save
+	for(int i = 0; i < journalRecords.size(); i++){
+		if(journalRecords[i].type == DURATION_JOURNAL_TRACK){
+			journalSnapshots[journalRecords[i].track] = i;
+		}
+		journaledTracks.insert(journalRecords[i].track);
+	}
+	unsigned long long journalMillis = ofGetElapsedTimeMillis() - phaseStart;
+	phaseStart = ofGetElapsedTimeMillis();
+
 	lock();
 
     timeline.removeFromThread();
     headers.clear(); //smart pointers will call destructor
     timeline.reset();
     timeline.setup();
+	oscIndexDirty = true;
 
 	if(audioTrack != NULL){
 		delete audioTrack;
@@ -3497,8 +2795,56 @@ void DurationController::loadProject(string projectPath, string projectName, boo
             string trackName = projectSettings.getValue("trackName","");
             string trackFilePath = ofToDataPath(projectPath + "/" + xmlFileName);
 
+			//keys come from the store unless the XML was saved after it, from a journal
+			//snapshot, or from the parser. those tracks are added without the timeline
+			//reading their XML, the rest are read as they are added
+			map<string, int>::iterator snapshot = journalSnapshots.find(trackName);
+			bool fromStore = snapshot == journalSnapshots.end() && keyframeStore.hasTrack(trackName) && keyframeStore.isCurrentFor(trackFilePath);
+			bool parsed = trackType == "curves" || trackType == "bangs";
+			//tracks after the first page are added empty the same way and read later
+			bool deferred = p > 0 && trackType != "audio" && journaledTracks.find(trackName) == journaledTracks.end();
+			bool readLater = fromStore || parsed || deferred || snapshot != journalSnapshots.end();
+
 			//add the track
-            ofxTLTrack* newTrack = addTrack(trackType, trackName, trackFilePath);
+            ofxTLTrack* newTrack = addTrack(trackType, trackName, trackFilePath, !readLater);
+			if(newTrack != NULL && newTrack->getTrackType() != "Audio" && snapshot != journalSnapshots.end()){
+				ofxTLKeyframes* keyframes = (ofxTLKeyframes*)newTrack;
+				ofxXmlSettings recovered;
+				if(recovered.loadFromBuffer(journalRecords[snapshot->second].xml)){
+					DurationKeyframeAccess::readKeyframes(keyframes, recovered, DurationKeyframeAccess::getKeyframes(keyframes));
+					DurationKeyframeAccess::sortKeyframes(keyframes);
+				}
+				else{
+					ofLogError("DurationController::loadProject") << "Could not read the journaled keys of " << trackName << ", loading its file";
+					keyframes->load();
+				}
+				recoveredPaths.push_back(trackFilePath);
+			}
+			else if(newTrack != NULL && deferred){
+				headers[newTrack->getName()]->keysDeferred = true;
+				DurationDeferredTrack deferredTrack;
+				deferredTrack.track = newTrack;
+				deferredTrack.fromStore = fromStore;
+				deferredTrack.loaded = false;
+				deferredTrack.fingerprint = 0;
+				deferredTrack.onDisk = false;
+				deferredTracks.push_back(deferredTrack);
+				numDeferredTracks++;
+			}
+			else if(newTrack != NULL && newTrack->getTrackType() != "Audio"){
+				int numKeyframes = fromStore ? keyframeStore.load((ofxTLKeyframes*)newTrack) : -1;
+				if(numKeyframes >= 0){
+					numStoredKeyframes += numKeyframes;
+				}
+				else if(DurationKeyframeParser::canParse(newTrack->getTrackType())){
+					keyframeParser.add((ofxTLKeyframes*)newTrack, trackFilePath);
+					numXMLTracks++;
+				}
+				else{
+					//read by the timeline as it was added
+					numXMLTracks++;
+				}
+			}
 
 			//custom setup
 			if(newTrack != NULL){
@@ -3507,6 +2853,9 @@ void DurationController::loadProject(string projectPath, string projectName, boo
 					headerTrack->setValueRange(ofRange(projectSettings.getValue("min", 0.0),
 													   projectSettings.getValue("max", 1.0)));
 				}
+				else if(newTrack->getTrackType() == "Colors" && headless){
+					headlessPalettes[trackName] = projectSettings.getValue("palette", timeline.getDefaultColorPalettePath());
+				}
 				else if(newTrack->getTrackType() == "Colors"){
 					ofxTLColorTrack* colors = (ofxTLColorTrack*)newTrack;
 					colors->loadColorPalette(projectSettings.getValue("palette", timeline.getDefaultColorPalettePath()));
@@ -3529,14 +2878,38 @@ void DurationController::loadProject(string projectPath, string projectName, boo
 
 				headerTrack->setSendOSC(projectSettings.getValue("sendOSC", true));
 				headerTrack->setReceiveOSC(projectSettings.getValue("receiveOSC", true));
+				headerTrack->setOutputRate(projectSettings.getValue("outputRate", 0.0));
+				headerTrack->setSendOnChange(projectSettings.getValue("sendOnChange", true));
+				headerTrack->setOutputDeadband(projectSettings.getValue("deadband", 0.0));
+				headerTrack->setOutputDeadbandRelative(projectSettings.getValue("deadbandRelative", false));
+				headerTrack->setOutputQuantizeSteps(projectSettings.getValue("quantizeSteps", 0));
+				headerTrack->setOutputRefreshSeconds(projectSettings.getValue("refreshSeconds", 0.0));
 			}
             projectSettings.popTag(); //track
         }
         projectSettings.popTag(); //page
     }
+	unsigned long long tracksMillis = ofGetElapsedTimeMillis() - phaseStart;
+
+	//curve and bang files are parsed side by side, only putting their keys in the tracks is serial
+	phaseStart = ofGetElapsedTimeMillis();
+	keyframeParser.parse(DurationKeyframeParser::getDefaultNumThreads());
+	unsigned long long parseMillis = ofGetElapsedTimeMillis() - phaseStart;
+	phaseStart = ofGetElapsedTimeMillis();
+	int numParsedKeyframes = keyframeParser.insert();
+	unsigned long long insertMillis = ofGetElapsedTimeMillis() - phaseStart;
 
     timeline.moveToThread(); //increases accuracy of bang call backs
 
+	//what is on disk now is what a save would skip, the snapshots and replayed keys are not
+	phaseStart = ofGetElapsedTimeMillis();
+	rememberSavedTracks();
+	for(int i = 0; i < recoveredPaths.size(); i++){
+		savedFingerprints.erase(recoveredPaths[i]);
+	}
+	int numRecovered = journalSnapshots.size() + replayJournalKeys(journalRecords, journalSnapshots);
+	unsigned long long replayMillis = ofGetElapsedTimeMillis() - phaseStart;
+	phaseStart = ofGetElapsedTimeMillis();
 
 	unlock();
 
@@ -3553,25 +2926,51 @@ void DurationController::loadProject(string projectPath, string projectName, boo
     bool loops = projectSettings.getValue("loop", true);
     timeline.setLoopType(loops ? OF_LOOP_NORMAL : OF_LOOP_NONE);
 
-    durationLabel->setTextString(timeline.getDurationInTimecode());
-    loopToggle->setValue( loops );
     projectSettings.popTag(); //timeline settings;
 
     DurationProjectSettings newSettings;
     projectSettings.pushTag("projectSettings");
 
-    useBPMToggle->setValue( newSettings.useBPM = projectSettings.getValue("useBPM", true) );
-    bpmDialer->setValue( newSettings.bpm = projectSettings.getValue("bpm", 120.0f) );
+    newSettings.useBPM = projectSettings.getValue("useBPM", true);
+    newSettings.bpm = projectSettings.getValue("bpm", 120.0f);
 //    snapToBPMToggle->setValue( newSettings.snapToBPM = projectSettings.getValue("snapToBPM", true) );
 //    snapToKeysToggle->setValue( newSettings.snapToKeys = projectSettings.getValue("snapToKeys", true) );
-    enableOSCInToggle->setValue( newSettings.oscInEnabled = projectSettings.getValue("oscInEnabled", true) );
-	enableOSCOutToggle->setValue( newSettings.oscOutEnabled = projectSettings.getValue("oscOutEnabled", true) );
-    oscInPortInput->setTextString( ofToString(newSettings.oscInPort = projectSettings.getValue("oscInPort", 12346)) );
-    oscOutIPInput->setTextString( newSettings.oscIP = projectSettings.getValue("oscIP", "localhost") );
-    oscOutIPInput->setTextString( newSettings.oscIP = projectSettings.getValue("Display2IP", "localhost") );
-    oscOutPortInput->setTextString( ofToString(newSettings.oscOutPort = projectSettings.getValue("oscOutPort", 12345)) );
-    oscOutPortInput->setTextString( ofToString(newSettings.oscOutPort = projectSettings.getValue("Display2Port", 12345)) );
+    newSettings.oscInEnabled = projectSettings.getValue("oscInEnabled", true);
+	newSettings.oscOutEnabled = projectSettings.getValue("oscOutEnabled", true);
+	newSettings.oscMulticast = projectSettings.getValue("oscMulticast", false);
+	newSettings.oscMulticastTTL = projectSettings.getValue("oscMulticastTTL", 1);
+	newSettings.oscMulticastInterface = projectSettings.getValue("oscMulticastInterface", "");
+    newSettings.oscInPort = projectSettings.getValue("oscInPort", 12346);
+    newSettings.oscIP = projectSettings.getValue("oscIP", "localhost");
+    newSettings.oscOutPort = projectSettings.getValue("oscOutPort", 12345);
+	if(projectSettings.tagExists("oscDestinations")){
+		projectSettings.pushTag("oscDestinations");
+		for(int i = 0; i < projectSettings.getNumTags("destination"); i++){
+			projectSettings.pushTag("destination", i);
+			DurationOscDestination destination;
+			destination.host = projectSettings.getValue("ip", "localhost");
+			destination.port = projectSettings.getValue("port", 12345);
+			destination.enabled = projectSettings.getValue("enabled", true);
+			destination.addressFilter = projectSettings.getValue("filter", "");
+			newSettings.oscDestinations.push_back(destination);
+			projectSettings.popTag(); //destination
+		}
+		projectSettings.popTag(); //oscDestinations
+	}
+	//older projects kept a second display here, which used to replace oscIP
+	else if(projectSettings.tagExists("Display2IP")){
+		DurationOscDestination destination;
+		destination.host = projectSettings.getValue("Display2IP", "localhost");
+		destination.port = projectSettings.getValue("Display2Port", 12345);
+		destination.enabled = true;
+		if(destination.host != newSettings.oscIP || destination.port != newSettings.oscOutPort){
+			newSettings.oscDestinations.push_back(destination);
+		}
+	}
 	newSettings.oscRate = projectSettings.getValue("oscRate", 30.0);
+	newSettings.oscLookahead = projectSettings.getValue("oscLookahead", 0.0);
+	newSettings.oscBakeCurves = projectSettings.getValue("oscBakeCurves", false);
+	newSettings.binaryKeyframes = binaryKeyframes;
 	oscFrequency = 1000 * 1/newSettings.oscRate; //frequence in millis
 
     projectSettings.popTag(); //project settings;
@@ -3581,7 +2980,19 @@ void DurationController::loadProject(string projectPath, string projectName, boo
     newSettings.settingsPath = ofToDataPath(newSettings.path + "/.durationproj");
     settings = newSettings;
 
-    projectDropDown->setLabelText(projectName);
+	if(!headless){
+		durationLabel->setTextString(timeline.getDurationInTimecode());
+		loopToggle->setValue(loops);
+		useBPMToggle->setValue(settings.useBPM);
+		bpmDialer->setValue(settings.bpm);
+		enableOSCInToggle->setValue(settings.oscInEnabled);
+		enableOSCOutToggle->setValue(settings.oscOutEnabled);
+		multicastToggle->setValue(settings.oscMulticast);
+		oscInPortInput->setTextString(ofToString(settings.oscInPort));
+		oscOutIPInput->setTextString(settings.oscIP);
+		oscOutPortInput->setTextString(ofToString(settings.oscOutPort));
+		projectDropDown->setLabelText(projectName);
+	}
     timeline.setShowBPMGrid(newSettings.useBPM);
     timeline.enableSnapToBPM(newSettings.useBPM);
 	timeline.setBPM(newSettings.bpm);
@@ -3590,10 +3001,10 @@ void DurationController::loadProject(string projectPath, string projectName, boo
 	if(settings.oscInEnabled){
 		receiver.setup(settings.oscInPort);
 	}
-	if(settings.oscOutEnabled){
-        sender.setup(settings.oscIP, settings.oscOutPort);
-    }
+	//the remote panels send through this socket even when track output is off
+	setupSender();
 	oscLock.unlock();
+	oscWakeup.notify();
 
     ofxXmlSettings defaultSettings;
     defaultSettings.loadFile("settings.xml");
@@ -3601,14 +3012,334 @@ void DurationController::loadProject(string projectPath, string projectName, boo
     defaultSettings.setValue("lastProjectName", settings.name);
     defaultSettings.saveFile();
 
-	needsSave = false;
+	if(numDeferredTracks == 0){
+		keyframeStore.close();
+	}
+	deferredStart = ofGetElapsedTimeMillis();
+	journal.open(projectPath);
+	//a journal left over from a crash is only removed by a save of this project
+	journalSaveGeneration = -1;
+	journaledFingerprints.clear();
+	journalTracks(false);
+	if(numRecovered > 0){
+		ofLogNotice("DurationController::loadProject") << "Recovered " << numRecovered << " journaled edits that were never saved";
+		curvesChanged = true;
+	}
+	ofLogNotice("DurationController::loadProject") << "Opened " << projectName << " in " << ofGetElapsedTimeMillis() - loadStart << " ms, "
+		<< numStoredKeyframes << " keyframes from .durationkeys, " << numXMLTracks << " tracks from XML, " << numDeferredTracks << " tracks on later pages to follow";
+	ofLogNotice("DurationController::loadProject") << "Project file " << projectMillis << " ms, journal " << journalMillis << " ms, tracks " << tracksMillis
+		<< " ms, parsing " << keyframeParser.getNumTracks() << " files " << parseMillis << " ms on " << keyframeParser.getNumThreads() << " threads ("
+		<< keyframeParser.getParseMillis() << " ms of work), inserting " << numParsedKeyframes << " keys " << insertMillis << " ms, replay " << replayMillis
+		<< " ms, settings " << ofGetElapsedTimeMillis() - phaseStart << " ms";
+
+	needsSave = numRecovered > 0;
 	sendInfoMessage();
 }
 
 //--------------------------------------------------------------
+//tells saves and the journal whether a track changed. keys the fingerprint can't see,
+//like flag text or LFO shapes, are compared by their XML, which is kept in xml
+static unsigned long long getTrackFingerprint(ofxTLKeyframes* keyframes, string& xml){
+	string trackType = keyframes->getTrackType();
+	if(trackType == "Curves" || trackType == "Bangs"){
+		return DurationKeyframeAccess::getFingerprint(keyframes);
+	}
+	xml = DurationKeyframeAccess::getXMLString(keyframes);
+	return std::hash<string>()(xml);
+}
+
+bool DurationController::hasDeferredTracks(){
+	deferredLock.lock();
+	bool waiting = false;
+	for(int i = 0; i < deferredTracks.size() && !waiting; i++){
+		waiting = !deferredTracks[i].loaded;
+	}
+	deferredLock.unlock();
+	return waiting;
+}
+
+bool DurationController::isDeferred(ofxTLTrack* track){
+	deferredLock.lock();
+	bool waiting = false;
+	for(int i = 0; i < deferredTracks.size() && !waiting; i++){
+		waiting = deferredTracks[i].track == track && !deferredTracks[i].loaded;
+	}
+	deferredLock.unlock();
+	return waiting;
+}
+
+//reads the track's keys if it hasn't been yet, on the main thread only. the OSC
+//thread skips the track until noteLoadedTracks clears its header's keysDeferred
+void DurationController::loadDeferredTrack(ofxTLTrack* track){
+	deferredLock.lock();
+	DurationDeferredTrack* deferred = findDeferredTrack(track);
+	if(deferred == NULL || deferred->loaded){
+		deferredLock.unlock();
+		return;
+	}
+	bool fromStore = deferred->fromStore;
+	deferredLock.unlock();
+
+	ofxTLKeyframes* keyframes = (ofxTLKeyframes*)track;
+	if(!fromStore || keyframeStore.load(keyframes) < 0){
+		keyframes->load();
+	}
+	string xml;
+	unsigned long long fingerprint = getTrackFingerprint(keyframes, xml);
+	bool onDisk = ofFile::doesFileExist(keyframes->getXMLFileName());
+
+	deferredLock.lock();
+	deferred = findDeferredTrack(track);
+	if(deferred != NULL){
+		deferred->loaded = true;
+		deferred->fingerprint = fingerprint;
+		deferred->onDisk = onDisk;
+	}
+	deferredLock.unlock();
+}
+
+DurationDeferredTrack* DurationController::findDeferredTrack(ofxTLTrack* track){
+	for(int i = 0; i < deferredTracks.size(); i++){
+		if(deferredTracks[i].track == track){
+			return &deferredTracks[i];
+		}
+	}
+	return NULL;
+}
+
+int DurationController::loadDeferredTracks(ofxTLPage* page, int limit){
+	vector<ofxTLTrack*> waiting;
+	deferredLock.lock();
+	for(int i = 0; i < deferredTracks.size(); i++){
+		if(!deferredTracks[i].loaded){
+			waiting.push_back(deferredTracks[i].track);
+		}
+	}
+	deferredLock.unlock();
+
+	int numLoaded = 0;
+	for(int i = 0; i < waiting.size() && numLoaded != limit; i++){
+		if(page == NULL || page->getTrack(waiting[i]->getName()) == waiting[i]){
+			loadDeferredTrack(waiting[i]);
+			numLoaded++;
+		}
+	}
+	return numLoaded;
+}
+
+//tracks read since the last call match their files and the journal
+void DurationController::noteLoadedTracks(){
+	deferredLock.lock();
+	if(deferredTracks.empty()){
+		deferredLock.unlock();
+		return;
+	}
+	vector<string> loadedNames;
+	for(int i = deferredTracks.size() - 1; i >= 0; i--){
+		if(!deferredTracks[i].loaded){
+			continue;
+		}
+		DurationDeferredTrack& deferred = deferredTracks[i];
+		if(deferred.onDisk){
+			savedFingerprints[deferred.track->getXMLFileName()] = deferred.fingerprint;
+		}
+		journaledFingerprints[deferred.track->getName()] = deferred.fingerprint;
+		loadedNames.push_back(deferred.track->getName());
+		deferredTracks.erase(deferredTracks.begin() + i);
+	}
+	if(deferredTracks.empty()){
+		keyframeStore.close();
+		ofLogNotice("DurationController") << "Read the tracks of later pages " << ofGetElapsedTimeMillis() - deferredStart << " ms after opening";
+	}
+	deferredLock.unlock();
+
+	//the OSC thread can use them from here on
+	if(!loadedNames.empty()){
+		lock();
+		for(int i = 0; i < loadedNames.size(); i++){
+			map<string, ofPtr<ofxTLUIHeader> >::iterator header = headers.find(loadedNames[i]);
+			if(header != headers.end()){
+				header->second->keysDeferred = false;
+			}
+		}
+		unlock();
+	}
+}
+
+void DurationController::clearDeferredTracks(){
+	deferredLock.lock();
+	deferredTracks.clear();
+	keyframeStore.close();
+	deferredLock.unlock();
+}
+
+//--------------------------------------------------------------
+//tracks just loaded match their files, so the next save can skip them
+void DurationController::rememberSavedTracks(){
+	savedFingerprints.clear();
+	savingFingerprints.clear();
+	vector<ofxTLPage*>& pages = timeline.getPages();
+	for(int i = 0; i < pages.size(); i++){
+		vector<ofxTLTrack*>& tracks = pages[i]->getTracks();
+		for(int t = 0; t < tracks.size(); t++){
+			string path = tracks[t]->getXMLFileName();
+			if(tracks[t]->getTrackType() != "Audio" && !isDeferred(tracks[t]) && ofFile::doesFileExist(path)){
+				string xml;
+				savedFingerprints[path] = getTrackFingerprint((ofxTLKeyframes*)tracks[t], xml);
+			}
+		}
+	}
+}
+
+//snapshots the tracks that changed since they were last journaled or loaded
+void DurationController::journalTracks(bool journalChanges){
+	journalEditPending = false;
+	noteLoadedTracks();
+	vector<ofxTLPage*>& pages = timeline.getPages();
+	for(int i = 0; i < pages.size(); i++){
+		vector<ofxTLTrack*>& tracks = pages[i]->getTracks();
+		for(int t = 0; t < tracks.size(); t++){
+			if(tracks[t]->getTrackType() == "Audio" || isDeferred(tracks[t])){
+				continue;
+			}
+			ofxTLKeyframes* keyframes = (ofxTLKeyframes*)tracks[t];
+			string xml;
+			unsigned long long fingerprint = getTrackFingerprint(keyframes, xml);
+			map<string, unsigned long long>::iterator journaled = journaledFingerprints.find(tracks[t]->getName());
+			if(journaled != journaledFingerprints.end() && journaled->second == fingerprint){
+				continue;
+			}
+			journaledFingerprints[tracks[t]->getName()] = fingerprint;
+			if(journalChanges){
+				journal.addTrack(tracks[t]->getName(), xml.empty() ? DurationKeyframeAccess::getXMLString(keyframes) : xml);
+			}
+		}
+	}
+}
+
+//adds keys recorded after their track's last snapshot, one sort per track. a key
+//already at the same time came from an earlier replay or save and is updated instead
+int DurationController::replayJournalKeys(vector<DurationJournalRecord>& records, map<string, int>& snapshots){
+	map<string, ofxTLKeyframes*> tracksByName;
+	vector<ofxTLPage*>& pages = timeline.getPages();
+	for(int i = 0; i < pages.size(); i++){
+		vector<ofxTLTrack*>& tracks = pages[i]->getTracks();
+		for(int t = 0; t < tracks.size(); t++){
+			if(tracks[t]->getTrackType() == "Curves" || tracks[t]->getTrackType() == "Bangs"){
+				tracksByName[tracks[t]->getName()] = (ofxTLKeyframes*)tracks[t];
+			}
+		}
+	}
+
+	map<ofxTLKeyframes*, int> sortedKeys; //keys in order before the replay
+	int numReplayed = 0;
+	for(int i = 0; i < records.size(); i++){
+		DurationJournalRecord& record = records[i];
+		if(record.type != DURATION_JOURNAL_KEY){
+			continue;
+		}
+		map<string, int>::iterator snapshot = snapshots.find(record.track);
+		map<string, ofxTLKeyframes*>::iterator found = tracksByName.find(record.track);
+		if((snapshot != snapshots.end() && snapshot->second > i) || found == tracksByName.end()){
+			continue;
+		}
+
+		ofxTLKeyframes* track = found->second;
+		vector<ofxTLKeyframe*>& keys = DurationKeyframeAccess::getKeyframes(track);
+		if(sortedKeys.find(track) == sortedKeys.end()){
+			sortedKeys[track] = keys.size();
+		}
+		float value = ofMap(record.value, track->getValueRange().min, track->getValueRange().max, 0, 1, true);
+
+		int low = 0;
+		int high = sortedKeys[track];
+		while(low < high){
+			int mid = (low + high) / 2;
+			if(keys[mid]->time < record.millis){
+				low = mid + 1;
+			}
+			else{
+				high = mid;
+			}
+		}
+		if(low < sortedKeys[track] && keys[low]->time == record.millis){
+			keys[low]->value = value;
+		}
+		else{
+			ofxTLKeyframe* key = DurationKeyframeAccess::createKeyframe(track);
+			key->time = record.millis;
+			key->value = value;
+			keys.push_back(key);
+		}
+		numReplayed++;
+	}
+
+	for(map<ofxTLKeyframes*, int>::iterator it = sortedKeys.begin(); it != sortedKeys.end(); it++){
+		DurationKeyframeAccess::sortKeyframes(it->first);
+	}
+	return numReplayed;
+}
+
+//copies the changed tracks and the project file into memory and hands them to projectWriter,
+//the playhead and OSC output carry on while they are written
 void DurationController::saveProject(){
+	//edits from here on go to a fresh journal, the old one goes once this save is on disk
+	if(journalEditPending){
+		journalTracks(true);
+	}
+	journal.rotate();
+	journalSaveGeneration = -1; //set again once this save is queued
+
+	unsigned long long snapshotStart = ofGetElapsedTimeMillis();
+	noteLoadedTracks();
+	vector<DurationSaveFile> files;
+	int numTracks = 0;
+	bool storeChanged = false;
+	vector<ofxTLPage*>& trackPages = timeline.getPages();
+	for(int i = 0; i < trackPages.size(); i++){
+		vector<ofxTLTrack*>& tracks = trackPages[i]->getTracks();
+		for(int t = 0; t < tracks.size(); t++){
+			//audio keeps no keyframes of its own
+			string trackType = tracks[t]->getTrackType();
+			if(trackType == "Audio"){
+				continue;
+			}
+			numTracks++;
+			//tracks not read yet are as they were saved
+			if(isDeferred(tracks[t])){
+				continue;
+			}
+
+			//skip tracks that match what was last written
+			ofxTLKeyframes* keyframes = (ofxTLKeyframes*)tracks[t];
+			string path = tracks[t]->getXMLFileName();
+			string xml;
+			unsigned long long fingerprint = getTrackFingerprint(keyframes, xml);
+			map<string, unsigned long long>::iterator saved = savedFingerprints.find(path);
+			if(saved != savedFingerprints.end() && saved->second == fingerprint){
+				continue;
+			}
+			savingFingerprints[path] = fingerprint;
+			storeChanged |= trackType == "Curves" || trackType == "Bangs";
 
-	timeline.save();
+			DurationSaveFile file;
+			file.path = path;
+			file.contents = xml.empty() ? DurationKeyframeAccess::getXMLString(keyframes) : xml;
+			files.push_back(file);
+		}
+	}
+	ofLogVerbose("DurationController::saveProject") << "Saving " << files.size() << " of " << numTracks << " tracks";
+
+	//the store holds every curve and bang track, it is rebuilt when any of them changed
+	if(settings.binaryKeyframes && (storeChanged || !ofFile::doesFileExist(settings.path + "/.durationkeys"))){
+		//the store covers every track, and the old one can't be replaced while it is mapped
+		loadDeferredTracks(NULL, -1);
+		noteLoadedTracks();
+		DurationSaveFile store;
+		store.path = settings.path + "/.durationkeys";
+		DurationKeyframeStore::build(timeline, store.contents);
+		files.push_back(store);
+	}
 
     ofxXmlSettings projectSettings;
     //SAVE ALL TRACKS
@@ -3633,7 +3364,13 @@ void DurationController::saveProject(){
             //save custom gui props
             projectSettings.addValue("sendOSC", headers[trackName]->sendOSC());
 			projectSettings.addValue("receiveOSC", headers[trackName]->receiveOSC());
+			projectSettings.addValue("outputRate", headers[trackName]->getOutputRate());
+			projectSettings.addValue("sendOnChange", headers[trackName]->getSendOnChange());
             if(trackType == "Curves" || trackType == "LFO"){
+				projectSettings.addValue("deadband", headers[trackName]->getOutputDeadband());
+				projectSettings.addValue("deadbandRelative", headers[trackName]->getOutputDeadbandRelative());
+				projectSettings.addValue("quantizeSteps", headers[trackName]->getOutputQuantizeSteps());
+				projectSettings.addValue("refreshSeconds", headers[trackName]->getOutputRefreshSeconds());
                 ofxTLKeyframes* curves = (ofxTLKeyframes*)tracks[t];
                 projectSettings.addValue("min", curves->getValueRange().min);
                 projectSettings.addValue("max", curves->getValueRange().max);
@@ -3641,7 +3378,8 @@ void DurationController::saveProject(){
             }
 			else if(trackType == "Colors"){
 				ofxTLColorTrack* colors = (ofxTLColorTrack*)tracks[t];
-				projectSettings.addValue("palette", colors->getPalettePath());
+				map<string, string>::iterator palette = headlessPalettes.find(trackName);
+				projectSettings.addValue("palette", palette != headlessPalettes.end() ? palette->second : colors->getPalettePath());
 			}
 			else if(trackType == "Audio"){
 				projectSettings.addValue("clip", audioTrack->getSoundfilePath());
@@ -3674,23 +3412,56 @@ void DurationController::saveProject(){
 
     projectSettings.addValue("oscInEnabled", settings.oscInEnabled);
     projectSettings.addValue("oscOutEnabled", settings.oscOutEnabled);
+	projectSettings.addValue("oscMulticast", settings.oscMulticast);
+	projectSettings.addValue("oscMulticastTTL", settings.oscMulticastTTL);
+	projectSettings.addValue("oscMulticastInterface", settings.oscMulticastInterface);
     projectSettings.addValue("oscInPort", settings.oscInPort);
-    projectSettings.addValue("oscIP", settings.oscIP);
-    projectSettings.addValue("Display2IP", settings.oscIP);
-    projectSettings.addValue("oscOutPort", settings.oscOutPort);
-    projectSettings.addValue("Display2Port", settings.oscOutPort);
+    projectSettings.addValue("oscIP", settings.oscIP);
+    projectSettings.addValue("oscOutPort", settings.oscOutPort);
+	projectSettings.addTag("oscDestinations");
+	projectSettings.pushTag("oscDestinations");
+	for(int i = 0; i < settings.oscDestinations.size(); i++){
+		projectSettings.addTag("destination");
+		projectSettings.pushTag("destination", i);
+		projectSettings.addValue("ip", settings.oscDestinations[i].host);
+		projectSettings.addValue("port", settings.oscDestinations[i].port);
+		projectSettings.addValue("enabled", settings.oscDestinations[i].enabled);
+		projectSettings.addValue("filter", settings.oscDestinations[i].addressFilter);
+		projectSettings.popTag(); //destination
+	}
+	projectSettings.popTag(); //oscDestinations
 	projectSettings.addValue("oscRate", settings.oscRate);
+	projectSettings.addValue("oscLookahead", settings.oscLookahead);
+	projectSettings.addValue("oscBakeCurves", settings.oscBakeCurves);
+	projectSettings.addValue("binaryKeyframes", settings.binaryKeyframes);
 
 //	projectSettings.addValue("zoomViewMin",timeline.getZoomer()->getSelectedRange().min);
 //	projectSettings.addValue("zoomViewMax",timeline.getZoomer()->getSelectedRange().max);
 
 	projectSettings.popTag(); //projectSettings
-    projectSettings.saveFile(settings.settingsPath);
+
+	DurationSaveFile project;
+	project.path = settings.settingsPath;
+	projectSettings.copyXmlToString(project.contents);
+	files.push_back(project);
+	ofLogVerbose("DurationController::saveProject") << "Copied " << files.size() << " files to save in " << ofGetElapsedTimeMillis() - snapshotStart << " ms";
+	journalSaveGeneration = projectWriter.save(files);
 
 	needsSave = false;
 }
 
 //--------------------------------------------------------------
+//--------------------------------------------------------------
+//there is no display to open a dialog on when headless
+void DurationController::showError(string message){
+	if(headless){
+		ofLogError("DurationController") << message;
+	}
+	else{
+		ofSystemAlertDialog(message);
+	}
+}
+
 ofxTLUIHeader* DurationController::createHeaderForTrack(ofxTLTrack* track){
     ofxTLUIHeader* headerGui = new ofxTLUIHeader();
 	headerGui->translation = &translation;
@@ -3788,6 +3559,13 @@ void DurationController::createTooltips(){
 	oscOutTip.displayPoint = ofVec2f(oscOutTip.sourceRect.x, 55);
 	tooltips.push_back(oscOutTip);
 
+	//multicast
+	Tooltip multicastTip;
+	multicastTip.text = translation.translateKey("send to a multicast group");
+	multicastTip.sourceRect = *multicastToggle->getRect();
+	multicastTip.displayPoint = ofVec2f(multicastTip.sourceRect.x, 55);
+	tooltips.push_back(multicastTip);
+
 	//osc Out IP
 	Tooltip oscOutIPTip;
 	oscOutIPTip.text = translation.translateKey("remote IP");
@@ -3840,12 +3618,18 @@ void DurationController::drawTooltipDebug(){
 }
 
 void DurationController::exit(ofEventArgs& e){
+	projectWriter.close();
+	projectIndex.close();
+	journal.close();
 	lock();
 	timeline.removeFromThread();
 	headers.clear();
 	timeline.reset();
+	oscIndexDirty = true;
 	unlock();
 
 	ofLogNotice("DurationController") << "waiting for thread on exit";
+	stopThread();
+	oscWakeup.notify();
 	waitForThread(true);
 }
@@ -45,7 +45,95 @@
 #include "ofxLocalization.h"
 #include "ofxFTGLFont.h"
 #include "ofxTLAudioTrack.h"
-#include "ofxUIMidiMapper.h"
+#include "ofxUIMidiMapper.h"
+#include "DurationOscReceiver.h"
+#include "DurationWakeup.h"
+#include "DurationControlQueue.h"
+#include "DurationRemoteMap.h"
+#include "DurationOscSender.h"
+#include "DurationCurveBake.h"
+#include "DurationCurveBatch.h"
+#include "DurationKeyframeCursor.h"
+#include "DurationKeyframeStore.h"
+#include "DurationKeyframeParser.h"
+#include "DurationProjectIndex.h"
+#include "DurationProjectWriter.h"
+#include "DurationJournal.h"
+#include "DurationAllocationCounter.h"
+
+#include <unordered_map>
+#include <atomic>
+
+typedef enum {
+	DURATION_OSC_OPEN,
+	DURATION_OSC_NEW,
+	DURATION_OSC_SAVE,
+	DURATION_OSC_SET_DURATION,
+	DURATION_OSC_PLAY,
+	DURATION_OSC_STOP,
+	DURATION_OSC_RECORD,
+	DURATION_OSC_SEEK_TO_SECOND,
+	DURATION_OSC_SEEK_TO_POSITION,
+	DURATION_OSC_SEEK_TO_MILLIS,
+	DURATION_OSC_SEEK_TO_TIMECODE,
+	DURATION_OSC_ENABLE_OSC_OUT,
+	DURATION_OSC_OSC_RATE,
+	DURATION_OSC_ENABLE_OSC_IN,
+	DURATION_OSC_ADD_TRACK,
+	DURATION_OSC_REMOVE_TRACK,
+	DURATION_OSC_TRACK_NAME,
+	DURATION_OSC_VALUE_RANGE,
+	DURATION_OSC_VALUE_RANGE_MIN,
+	DURATION_OSC_VALUE_RANGE_MAX,
+	DURATION_OSC_COLOR_PALETTE,
+	DURATION_OSC_AUDIO_CLIP
+} DurationOscCommand;
+
+typedef enum {
+	DURATION_OUTPUT_CURVES, //Curves and LFO
+	DURATION_OUTPUT_SWITCHES,
+	DURATION_OUTPUT_COLORS,
+	DURATION_OUTPUT_AUDIO
+} DurationOutputType;
+
+//everything handleOscOut needs to send one track, built when the track list changes
+typedef struct {
+	ofxTLTrack* track;
+	ofPtr<ofxTLUIHeader> header;
+	DurationOutputType type;
+	string address;
+	//address and type tags in wire format, audio rebuilds it when the bin count changes
+	vector<char> prefix;
+	int prefixArgs;
+
+	//app millis when the track is next due, on its own rate. a float would lose
+	//whole milliseconds after a few hours of uptime
+	double nextSendTime;
+	bool forceSend;
+
+	//last values sent, to skip unchanged tracks
+	bool hasSentValue;
+	unsigned long lastSentTime;
+	float lastFloatSampled;
+	float lastFloatSent;
+	bool lastBoolSent;
+	ofColor lastColorSent;
+
+	//Curves sampled ahead at the track's period, when the project bakes curves
+	ofPtr<DurationCurveBake> bake;
+	int batchColumn; //column in curveBatch when on the project rate and fully baked, -1 otherwise
+	//Curves sampled live pick up the keyframe search where the last sample left it
+	DurationKeyframeCursor cursor;
+} DurationOutputDescriptor;
+
+typedef struct {
+	ofxTLTrack* track;
+	bool fromStore; //keys come from keyframeStore rather than the track's XML
+	bool loaded; //read, but not yet noted as saved
+	//taken right after the read, before recorded keys can land on the track
+	unsigned long long fingerprint;
+	bool onDisk; //the track's XML file exists, so a save can skip it while it matches
+} DurationDeferredTrack;
 
 typedef struct {
     string path; //full project path
@@ -58,11 +146,18 @@ typedef struct {
     bool snapToKeys;
 
 	float oscRate; // BUNDLES PER SECOND
+	float oscLookahead; // MILLIS AHEAD THE TIMELINE IS SAMPLED, 0 SENDS BUNDLES IMMEDIATELY
+	bool oscBakeCurves; // READ CURVES FROM SAMPLES TAKEN AT THEIR OUTPUT RATE
+	bool binaryKeyframes; // ALSO SAVE CURVES AND BANGS TO .durationkeys AND OPEN FROM IT
     bool oscInEnabled;
 	bool oscOutEnabled;
 	int oscInPort;
     string oscIP;
     int oscOutPort;
+	vector<DurationOscDestination> oscDestinations; // MORE PROJECTION NODES, BESIDES oscIP
+	bool oscMulticast; // oscIP IS A MULTICAST GROUP
+	int oscMulticastTTL;
+	string oscMulticastInterface; // LOCAL ADDRESS TO SEND THE GROUP ON, EMPTY FOR DEFAULT
 
 } DurationProjectSettings;
 
@@ -84,12 +179,16 @@ class DurationController : public ofThread
 	DurationController();
 	~DurationController();
 
-	void setup();
+	//headless plays the project out over OSC with no window, gui or fonts.
+	//projectPath opens that project instead of the last one
+	void setup(bool headless = false, string projectPath = "");
 
 	void enableInterface();
 	void disableInterface();
 	bool isInterfaceEnabled();
 	void panelGui();
+	//LPMT remote panels, page 0 is F3 and page 1 is F4
+	void createRemotePanels(int page);
 
 	void update(ofEventArgs& args);
 	void draw(ofEventArgs& args);
@@ -103,7 +202,8 @@ class DurationController : public ofThread
 	void guiEvent(ofxUIEventArgs& e);
     void exit(ofEventArgs& e);
 
-	ofxTLTrack* addTrack(string trackType, string trackName = "", string xmlFileName = "");
+	//without readKeys the track starts empty and its XML is left for the caller to read
+	ofxTLTrack* addTrack(string trackType, string trackName = "", string xmlFileName = "", bool readKeys = true);
 
     //control elements
     ofxUIDropDownList* projectDropDown;
@@ -123,6 +223,7 @@ class DurationController : public ofThread
 
     ofxUILabelToggle* enableOSCInToggle;
 	ofxUILabelToggle* enableOSCOutToggle;
+	ofxUILabelToggle* multicastToggle;
     ofxUITextInput* oscInPortInput;
     ofxUITextInput* oscOutIPInput;
     ofxUITextInput* oscOutPortInput;
@@ -131,6 +232,9 @@ class DurationController : public ofThread
     ofxUIDropDownList* addTrackDropDown;
 
     string defaultProjectDirectoryPath;
+	//projects in the drop down come from the index and follow its background scan
+	DurationProjectIndex projectIndex;
+	vector<string> listedProjects;
 	DurationProjectSettings settings;
 
 	void newProject(string projectPath);
@@ -146,6 +250,10 @@ class DurationController : public ofThread
 
   protected:
 	ofxTimeline timeline;
+	bool headless;
+	map<string, string> headlessPalettes; //by track name, palettes not loaded headless, saved back as they were
+	void createTopGui(vector<string>& projects);
+	void showError(string message);
     void bangFired(ofxTLBangEventArgs& bang);
 	vector<string> trackAddresses;
 
@@ -158,12 +266,32 @@ class DurationController : public ofThread
 	string newProjectPath;
     bool shouldLoadProject;
 	string projectToLoad;
-
-	ofxOscReceiver receiver;
-	ofxOscSender sender;
+	bool shouldSaveProject; //saves snapshot the tracks and journal, so they run on the main thread
+
+	DurationOscReceiver receiver;
+	DurationOscSender sender;
+	void setupSender();
+	//track output is encoded here, reused every bundle
+	DurationOscWriter oscWriter;
+	int oscWriterGrowths;
+	//allocations by bundles that had nothing new to set up, only counted in debug builds
+	unsigned long long steadyOscOutAllocations;
+
+	//wakes the OSC thread for incoming messages and settings changes
+	DurationWakeup oscWakeup;
+	unsigned long lastWakeupReport;
+	unsigned long droppedMessagesReported;
+
+	//remote panel changes, flushed as one bundle by the OSC thread
+	DurationControlQueue controlQueue;
+	float controlFrequency;
+	unsigned long lastControlFlush;
+	void flushControlQueue();
+	DurationRemoteMap remoteMap;
 
 	void threadedFunction();
 	void handleOscOut();
+	unsigned long getLookaheadTime(unsigned long millis, unsigned long lookahead);
 	void handleOscIn();
 	bool enabled;
 
@@ -184,13 +312,72 @@ class DurationController : public ofThread
 	vector<ofxOscMessage> bangsReceived;
 	map<string, ofPtr<ofxTLUIHeader> > headers;
 
+	//incoming address lookup and outgoing track descriptors, track entries are
+	//rebuilt when tracks are added, renamed or removed
+	unordered_map<string, DurationOscCommand> oscCommands;
+	unordered_map<string, vector<ofPtr<ofxTLUIHeader> > > oscTrackAddresses;
+	vector<DurationOutputDescriptor> outputDescriptors;
+	unordered_map<ofxTLUIHeader*, int> outputsByHeader; //index into outputDescriptors
+	map<string, string> indexedDisplayNames; //names the index was last marked for, on the GUI thread
+	std::atomic<bool> oscIndexDirty; //set on the GUI thread, the OSC thread rebuilds
+	std::atomic<bool> deferredTracksWanted; //set on the OSC thread when it met a track not read yet
+	bool timelineWasModal;
+	void checkDisplayNames();
+	void rebuildOscIndex();
+
 	ofxTLUIHeader* createHeaderForTrack(ofxTLTrack* track);
 	ofPtr<ofxTLUIHeader> getHeaderWithDisplayName(string name);
 
 	float oscFrequency; // 1 / BUNDLES PER SECOND * 1000
 	unsigned long lastOSCBundleSent;
+	unsigned long nextOSCBundleTime; // EARLIEST TRACK DEADLINE
+	int curveValuesSent;
+	int curveValuesSuppressed;
+	//set when keyframes or value ranges may have changed, from either thread. the OSC
+	//thread takes it and refreshes the baked curves
+	std::atomic<bool> curvesChanged;
+	int bakeBudget; //samples left to bake this bundle
+	int nextBakeCheck;
+	DurationCurveBatch curveBatch;
+	vector<DurationCurveBake*> batchBakes;
+	vector<float> batchValues;
+	float sampleCurve(DurationOutputDescriptor& output, float period, unsigned long millis);
 	ofxFTGLFont tooltipFont;
 	bool needsSave;
+	//saves are snapshotted here and written in the background
+	DurationProjectWriter projectWriter;
+	int savesShown;
+	float saveFinishedTime;
+	//only tracks that changed since they were last written are saved again,
+	//keyed by their XML file
+	map<string, unsigned long long> savedFingerprints;
+	//tracks in saves still being written, moved to savedFingerprints once they are on disk
+	map<string, unsigned long long> savingFingerprints;
+	void rememberSavedTracks();
+
+	//edits since the last save, replayed by loadProject when a session ends without saving
+	DurationJournal journal;
+	int journalSaveGeneration; //the save holding the rotated journal's edits, -1 before one is queued
+	map<string, unsigned long long> journaledFingerprints; //by track name
+	bool journalEditPending;
+	float lastJournalEdit;
+	//appends a snapshot of each track that changed, or only notes their state when not journaling
+	void journalTracks(bool journalChanges);
+	int replayJournalKeys(vector<DurationJournalRecord>& records, map<string, int>& snapshots);
+
+	//tracks off the first page open empty and get their keys after the first frame,
+	//one a frame, a page at a time when it is viewed, or each before it is sampled
+	vector<DurationDeferredTrack> deferredTracks;
+	ofMutex deferredLock;
+	DurationKeyframeStore keyframeStore; //open until the deferred tracks are in
+	unsigned long long deferredStart;
+	bool hasDeferredTracks();
+	bool isDeferred(ofxTLTrack* track);
+	void loadDeferredTrack(ofxTLTrack* track);
+	DurationDeferredTrack* findDeferredTrack(ofxTLTrack* track); //with deferredLock held
+	int loadDeferredTracks(ofxTLPage* page, int limit); //every page when NULL, no limit when -1
+	void noteLoadedTracks();
+	void clearDeferredTracks();
     bool allgui;
 	bool receivedAddTrack;
 	string oscTrackTypeReceived;
@@ -227,6 +414,10 @@ class DurationController : public ofThread
     ofxUISuperCanvas *gui8;
     ofxUISuperCanvas *gui9;
     ofxUISuperCanvas *gui11;
+	bool remotePanelsCreated[2];
+	bool remotePanelsMinified;
+	void createRemotePanelsF3();
+	void createRemotePanelsF4();
 
     ofxUITextInput *textinput;
 
@@ -0,0 +1,337 @@
+/**
+ * Duration
+ * Standalone timeline for Creative Code
+ *
+ * Copyright (c) 2012 James George
+ * Development Supported by YCAM InterLab http://interlab.ycam.jp/en/
+ * http://jamesgeorge.org + http://flightphase.com
+ * http://github.com/obviousjim + http://github.com/flightphase
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include "DurationCurveBake.h"
+#include "DurationKeyframeAccess.h"
+
+#define DURATION_BAKE_BLOCK_SIZE 256
+#define DURATION_BAKE_MAX_SAMPLES (1 << 22) //16MB of floats per track
+
+DurationCurveBake::DurationCurveBake(){
+	track = NULL;
+	interval = 0;
+	duration = 0;
+	tooLong = false;
+	numStale = 0;
+	version = 0;
+	bakedLFOHash = 0;
+}
+
+bool DurationCurveBake::setup(ofxTLKeyframes* bakeTrack, float intervalMillis, unsigned long durationMillis){
+	track = bakeTrack;
+	interval = intervalMillis;
+	duration = durationMillis;
+	samples.clear();
+	staleBlocks.clear();
+	numStale = 0;
+
+	tooLong = interval <= 0 || duration / interval + 1 > DURATION_BAKE_MAX_SAMPLES;
+	if(tooLong){
+		ofLogWarning("DurationCurveBake::setup") << track->getName() << " is too long to bake at " << interval << " ms, it will be read live";
+		return false;
+	}
+
+	samples.resize(duration / interval + 1);
+	invalidate();
+	return true;
+}
+
+bool DurationCurveBake::isSetup(float intervalMillis, unsigned long durationMillis){
+	return track != NULL && interval == intervalMillis && duration == durationMillis;
+}
+
+void DurationCurveBake::invalidate(){
+	int numBlocks = (samples.size() + DURATION_BAKE_BLOCK_SIZE - 1) / DURATION_BAKE_BLOCK_SIZE;
+	staleBlocks.assign(numBlocks, true);
+	numStale = numBlocks;
+	version++;
+	getKeys(bakedKeys);
+	bakedRange = track->getValueRange();
+	bakedLFOHash = getLFOHash();
+}
+
+void DurationCurveBake::invalidate(unsigned long fromMillis, unsigned long toMillis){
+	if(samples.empty()){
+		return;
+	}
+	//samples either side are interpolated into the range, so their blocks go too
+	int last = samples.size() - 1;
+	int firstBlock = MAX(MIN(int(fromMillis / interval) - 1, last), 0) / DURATION_BAKE_BLOCK_SIZE;
+	int lastBlock = MIN(int(toMillis / interval) + 1, last) / DURATION_BAKE_BLOCK_SIZE;
+	for(int block = firstBlock; block <= lastBlock; block++){
+		if(!staleBlocks[block]){
+			staleBlocks[block] = true;
+			numStale++;
+		}
+	}
+	version++;
+}
+
+bool DurationCurveBake::refresh(){
+	if(samples.empty()){
+		return false;
+	}
+	ofRange range = track->getValueRange();
+	if(range.min != bakedRange.min || range.max != bakedRange.max){
+		invalidate();
+		return true;
+	}
+	if(track->getTrackType() == "LFO"){
+		if(getLFOHash() == bakedLFOHash){
+			return false;
+		}
+		invalidate();
+		return true;
+	}
+
+	vector<DurationBakedKey> keys;
+	getKeys(keys);
+	//the keys before and after the edit are the same in both lists
+	int numKeys = keys.size();
+	int numBaked = bakedKeys.size();
+	int first = 0;
+	while(first < numKeys && first < numBaked && memcmp(&keys[first], &bakedKeys[first], sizeof(DurationBakedKey)) == 0){
+		first++;
+	}
+	if(first == numKeys && first == numBaked){
+		return false;
+	}
+	int fromEnd = 0;
+	while(fromEnd < numKeys - first && fromEnd < numBaked - first &&
+		  memcmp(&keys[numKeys - 1 - fromEnd], &bakedKeys[numBaked - 1 - fromEnd], sizeof(DurationBakedKey)) == 0){
+		fromEnd++;
+	}
+
+	//a key shapes the segments on both of its sides
+	unsigned long fromMillis = first > 0 ? keys[first - 1].time : 0;
+	unsigned long toMillis = fromEnd > 0 ? keys[numKeys - fromEnd].time : duration;
+	invalidate(fromMillis, toMillis);
+	bakedKeys.swap(keys);
+	return true;
+}
+
+void DurationCurveBake::keyAdded(unsigned long millis){
+	vector<ofxTLKeyframe*>& keyframes = DurationKeyframeAccess::getKeyframes(track);
+	unsigned long fromMillis = 0;
+	unsigned long toMillis = duration;
+	int low = 0;
+	int high = keyframes.size();
+	while(low < high){
+		int middle = (low + high) / 2;
+		if(keyframes[middle]->time < millis){
+			low = middle + 1;
+		}
+		else{
+			high = middle;
+		}
+	}
+	if(low > 0){
+		fromMillis = keyframes[low - 1]->time;
+	}
+	//the snapshot takes the new key too, so refresh() doesn't bake this range again
+	if(bakedKeys.size() + 1 == keyframes.size()){
+		vector<DurationBakedKey> key;
+		getKeys(key, low);
+		bakedKeys.insert(bakedKeys.begin() + low, key[0]);
+	}
+	//the new key is at low, or the first of several at this time
+	while(low < keyframes.size() && keyframes[low]->time <= millis){
+		low++;
+	}
+	if(low < keyframes.size()){
+		toMillis = keyframes[low]->time;
+	}
+	invalidate(fromMillis, toMillis);
+}
+
+int DurationCurveBake::update(unsigned long millis, int maxSamples){
+	if(numStale == 0 || maxSamples <= 0){
+		return 0;
+	}
+
+	//the part about to play is baked first
+	int numBlocks = staleBlocks.size();
+	int startBlock = MIN(int(millis / interval) / DURATION_BAKE_BLOCK_SIZE, numBlocks - 1);
+	int numSampled = 0;
+	for(int i = 0; i < numBlocks && numStale > 0 && numSampled < maxSamples; i++){
+		int block = (startBlock + i) % numBlocks;
+		if(staleBlocks[block]){
+			bakeBlock(block);
+			numSampled += DURATION_BAKE_BLOCK_SIZE;
+		}
+	}
+	return numSampled;
+}
+
+bool DurationCurveBake::isComplete(){
+	return !tooLong && numStale == 0;
+}
+
+bool DurationCurveBake::getValue(unsigned long millis, float& value){
+	if(samples.empty()){
+		return false;
+	}
+
+	float position = millis / interval;
+	int index = position;
+	int last = samples.size() - 1;
+	if(index >= last){
+		if(index > last || staleBlocks[last / DURATION_BAKE_BLOCK_SIZE]){
+			return false;
+		}
+		value = samples[last];
+		return true;
+	}
+
+	//the next sample can sit at the start of the following block
+	if(staleBlocks[index / DURATION_BAKE_BLOCK_SIZE] || staleBlocks[(index + 1) / DURATION_BAKE_BLOCK_SIZE]){
+		return false;
+	}
+	float a = samples[index];
+	float b = samples[index + 1];
+	value = a == b ? a : a + (b - a) * (position - index);
+	return true;
+}
+
+bool DurationCurveBake::verify(unsigned long millis){
+	if(samples.empty()){
+		return true;
+	}
+
+	int index = MIN(int(millis / interval + .5), int(samples.size()) - 1);
+	if(staleBlocks[index / DURATION_BAKE_BLOCK_SIZE]){
+		return true;
+	}
+	if(track->getValueAtTimeInMillis(getSampleTime(index)) != samples[index]){
+		if(!refresh()){
+			invalidate();
+		}
+		return false;
+	}
+	return true;
+}
+
+float DurationCurveBake::compare(int numProbes, float& bakedMicros, float& liveMicros){
+	bakedMicros = liveMicros = 0;
+	if(!isComplete() || numProbes <= 0){
+		return 0;
+	}
+
+	vector<unsigned long> times(numProbes);
+	vector<float> baked(numProbes);
+	vector<float> live(numProbes);
+	for(int i = 0; i < numProbes; i++){
+		times[i] = ofRandom(duration);
+	}
+
+	unsigned long long start = ofGetElapsedTimeMicros();
+	for(int i = 0; i < numProbes; i++){
+		getValue(times[i], baked[i]);
+	}
+	unsigned long long split = ofGetElapsedTimeMicros();
+	for(int i = 0; i < numProbes; i++){
+		live[i] = track->getValueAtTimeInMillis(times[i]);
+	}
+	unsigned long long end = ofGetElapsedTimeMicros();
+
+	bakedMicros = float(split - start) / numProbes;
+	liveMicros = float(end - split) / numProbes;
+
+	float maxError = 0;
+	for(int i = 0; i < numProbes; i++){
+		maxError = MAX(maxError, fabs(baked[i] - live[i]));
+	}
+	return maxError;
+}
+
+int DurationCurveBake::getNumSamples(){
+	return samples.size();
+}
+
+const vector<float>& DurationCurveBake::getSamples(){
+	return samples;
+}
+
+float DurationCurveBake::getInterval(){
+	return interval;
+}
+
+ofxTLKeyframes* DurationCurveBake::getTrack(){
+	return track;
+}
+
+int DurationCurveBake::getVersion(){
+	return version;
+}
+
+void DurationCurveBake::getKeys(vector<DurationBakedKey>& keys, int only){
+	vector<ofxTLKeyframe*>& keyframes = DurationKeyframeAccess::getKeyframes(track);
+	bool curves = track->getTrackType() == "Curves";
+	int first = only < 0 ? 0 : only;
+	int count = only < 0 ? keyframes.size() : 1;
+	keys.resize(count);
+	for(int i = 0; i < count; i++){
+		ofxTLKeyframe* keyframe = keyframes[first + i];
+		//zeroed so keys compare with memcmp
+		memset(&keys[i], 0, sizeof(DurationBakedKey));
+		keys[i].time = keyframe->time;
+		keys[i].value = keyframe->value;
+		if(curves){
+			ofxTLTweenKeyframe* tween = (ofxTLTweenKeyframe*)keyframe;
+			keys[i].easing = tween->easeFunc->id << 8 | tween->easeType->id;
+		}
+	}
+}
+
+//LFO keys are compared by the XML they save, which holds all of their settings
+size_t DurationCurveBake::getLFOHash(){
+	if(track->getTrackType() != "LFO"){
+		return 0;
+	}
+	return std::hash<string>()(DurationKeyframeAccess::getXMLString(track));
+}
+
+unsigned long DurationCurveBake::getSampleTime(int index){
+	return MIN((unsigned long)(index * interval + .5), duration);
+}
+
+void DurationCurveBake::bakeBlock(int block){
+	int first = block * DURATION_BAKE_BLOCK_SIZE;
+	int last = MIN(first + DURATION_BAKE_BLOCK_SIZE, int(samples.size()));
+	for(int i = first; i < last; i++){
+		samples[i] = track->getValueAtTimeInMillis(getSampleTime(i));
+	}
+	staleBlocks[block] = false;
+	numStale--;
+	version++;
+}
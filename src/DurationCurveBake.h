@@ -0,0 +1,110 @@
+/**
+ * Duration
+ * Standalone timeline for Creative Code
+ *
+ * Copyright (c) 2012 James George
+ * Development Supported by YCAM InterLab http://interlab.ycam.jp/en/
+ * http://jamesgeorge.org + http://flightphase.com
+ * http://github.com/obviousjim + http://github.com/flightphase
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#pragma once
+
+#include "ofMain.h"
+#include "ofxTimeline.h"
+
+//a key as it was when the track was last baked
+typedef struct {
+	unsigned long long time;
+	float value;
+	int easing; //easing function and type ids, curves only
+} DurationBakedKey;
+
+//A Curves or LFO track sampled once per output period, so playback reads
+//two floats instead of searching keyframes and evaluating tweens. Samples
+//are kept in blocks: an edit marks the blocks between the keys around it
+//stale, stale blocks are re-sampled a few at a time starting at the
+//playhead, and reads that land in a stale block return false so the caller
+//evaluates the track live.
+class DurationCurveBake {
+  public:
+	DurationCurveBake();
+
+	//returns false when the track is too long to bake at this interval
+	bool setup(ofxTLKeyframes* track, float intervalMillis, unsigned long durationMillis);
+	bool isSetup(float intervalMillis, unsigned long durationMillis);
+
+	void invalidate();
+	//marks the blocks holding samples from fromMillis to toMillis stale
+	void invalidate(unsigned long fromMillis, unsigned long toMillis);
+	//compares the track's keys with the ones last baked and marks stale only the time
+	//between the unchanged keys either side of the edit. LFO keys carry more than a
+	//time and value, so an LFO that changed is re-baked whole. false if nothing changed
+	bool refresh();
+	//a key was just added at millis, marks the time between its neighbours stale
+	void keyAdded(unsigned long millis);
+	//re-samples stale blocks starting at the one holding millis, returns the number of samples taken
+	int update(unsigned long millis, int maxSamples);
+	bool isComplete();
+
+	//interpolated between the two nearest samples, false if they are stale or missing
+	bool getValue(unsigned long millis, float& value);
+
+	//checks the sample nearest millis against the track and invalidates on a mismatch,
+	//catches edits that never reported a change
+	bool verify(unsigned long millis);
+
+	//times baked against live reads at random points, returns the largest difference
+	float compare(int numProbes, float& bakedMicros, float& liveMicros);
+
+	int getNumSamples();
+	const vector<float>& getSamples();
+	float getInterval();
+	ofxTLKeyframes* getTrack();
+	//changes whenever any sample does
+	int getVersion();
+
+  protected:
+	ofxTLKeyframes* track;
+	float interval;
+	unsigned long duration;
+	bool tooLong;
+
+	vector<float> samples;
+	vector<bool> staleBlocks;
+	int numStale;
+	int version;
+
+	vector<DurationBakedKey> bakedKeys;
+	ofRange bakedRange;
+	size_t bakedLFOHash;
+	//all keys, or only the key at the given index
+	void getKeys(vector<DurationBakedKey>& keys, int only = -1);
+	size_t getLFOHash();
+
+	unsigned long getSampleTime(int index);
+	void bakeBlock(int block);
+};
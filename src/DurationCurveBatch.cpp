@@ -0,0 +1,182 @@
+/**
+ * Duration
+ * Standalone timeline for Creative Code
+ *
+ * Copyright (c) 2012 James George
+ * Development Supported by YCAM InterLab http://interlab.ycam.jp/en/
+ * http://jamesgeorge.org + http://flightphase.com
+ * http://github.com/obviousjim + http://github.com/flightphase
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include "DurationCurveBatch.h"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define DURATION_BATCH_AVX
+#define DURATION_BATCH_SSE
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define DURATION_BATCH_SSE
+#endif
+
+#define DURATION_BATCH_WINDOW 512 //frames, 17 seconds at 30 bundles per second
+
+DurationCurveBatch::DurationCurveBatch(){
+	windowStart = 0;
+	windowFrames = 0;
+	windowValid = false;
+}
+
+bool DurationCurveBatch::setup(const vector<DurationCurveBake*>& newBakes){
+	bool changed = newBakes != bakes;
+	if(changed){
+		bakes = newBakes;
+		versions.assign(bakes.size(), -1);
+		windowValid = false;
+	}
+	for(int i = 0; i < bakes.size(); i++){
+		if(bakes[i]->getVersion() != versions[i]){
+			versions[i] = bakes[i]->getVersion();
+			windowValid = false;
+		}
+	}
+	return changed;
+}
+
+int DurationCurveBatch::getNumColumns(){
+	return bakes.size();
+}
+
+void DurationCurveBatch::evaluate(unsigned long millis, float* values){
+	if(bakes.empty()){
+		return;
+	}
+
+	const float* a;
+	const float* b;
+	float t;
+	getRows(millis, a, b, t);
+
+	int numColumns = bakes.size();
+	int c = 0;
+#ifdef DURATION_BATCH_AVX
+	__m256 t8 = _mm256_set1_ps(t);
+	for(; c + 8 <= numColumns; c += 8){
+		__m256 a8 = _mm256_loadu_ps(a + c);
+		__m256 b8 = _mm256_loadu_ps(b + c);
+		_mm256_storeu_ps(values + c, _mm256_add_ps(a8, _mm256_mul_ps(_mm256_sub_ps(b8, a8), t8)));
+	}
+#endif
+#ifdef DURATION_BATCH_SSE
+	__m128 t4 = _mm_set1_ps(t);
+	for(; c + 4 <= numColumns; c += 4){
+		__m128 a4 = _mm_loadu_ps(a + c);
+		__m128 b4 = _mm_loadu_ps(b + c);
+		_mm_storeu_ps(values + c, _mm_add_ps(a4, _mm_mul_ps(_mm_sub_ps(b4, a4), t4)));
+	}
+#endif
+	for(; c < numColumns; c++){
+		values[c] = a[c] + (b[c] - a[c]) * t;
+	}
+}
+
+void DurationCurveBatch::evaluateScalar(unsigned long millis, float* values){
+	if(bakes.empty()){
+		return;
+	}
+
+	const float* a;
+	const float* b;
+	float t;
+	getRows(millis, a, b, t);
+	for(int c = 0; c < bakes.size(); c++){
+		values[c] = a[c] + (b[c] - a[c]) * t;
+	}
+}
+
+float DurationCurveBatch::compare(unsigned long millis, float& liveDifference, float& batchMicros, float& liveMicros){
+	liveDifference = batchMicros = liveMicros = 0;
+	int numColumns = bakes.size();
+	if(numColumns == 0){
+		return 0;
+	}
+
+	vector<float> batch(numColumns);
+	vector<float> scalar(numColumns);
+	vector<float> live(numColumns);
+	evaluateScalar(millis, &scalar[0]); //fills the window outside the timing
+
+	unsigned long long start = ofGetElapsedTimeMicros();
+	evaluate(millis, &batch[0]);
+	unsigned long long split = ofGetElapsedTimeMicros();
+	for(int c = 0; c < numColumns; c++){
+		live[c] = bakes[c]->getTrack()->getValueAtTimeInMillis(millis);
+	}
+	unsigned long long end = ofGetElapsedTimeMicros();
+	batchMicros = split - start;
+	liveMicros = end - split;
+
+	float difference = 0;
+	for(int c = 0; c < numColumns; c++){
+		difference = MAX(difference, fabs(batch[c] - scalar[c]));
+		liveDifference = MAX(liveDifference, fabs(batch[c] - live[c]));
+	}
+	return difference;
+}
+
+void DurationCurveBatch::getRows(unsigned long millis, const float*& a, const float*& b, float& t){
+	int numSamples = bakes[0]->getNumSamples();
+	float position = millis / bakes[0]->getInterval();
+	int index = position;
+	t = position - index;
+	if(index >= numSamples - 1){
+		index = numSamples - 1;
+		t = 0;
+	}
+
+	//both rows have to be in the window, the last frame has no next row
+	int next = MIN(index + 1, numSamples - 1);
+	if(!windowValid || index < windowStart || next >= windowStart + windowFrames){
+		fillWindow(index);
+	}
+	int numColumns = bakes.size();
+	a = &window[(index - windowStart) * numColumns];
+	b = &window[(next - windowStart) * numColumns];
+}
+
+void DurationCurveBatch::fillWindow(int frame){
+	int numColumns = bakes.size();
+	windowStart = frame;
+	windowFrames = MIN(DURATION_BATCH_WINDOW, bakes[0]->getNumSamples() - frame);
+	window.resize(windowFrames * numColumns);
+	for(int c = 0; c < numColumns; c++){
+		const float* samples = &bakes[c]->getSamples()[windowStart];
+		for(int f = 0; f < windowFrames; f++){
+			window[f * numColumns + c] = samples[f];
+		}
+	}
+	windowValid = true;
+}
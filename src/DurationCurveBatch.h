@@ -0,0 +1,74 @@
+/**
+ * Duration
+ * Standalone timeline for Creative Code
+ *
+ * Copyright (c) 2012 James George
+ * Development Supported by YCAM InterLab http://interlab.ycam.jp/en/
+ * http://jamesgeorge.org + http://flightphase.com
+ * http://github.com/obviousjim + http://github.com/flightphase
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#pragma once
+
+#include "ofMain.h"
+#include "DurationCurveBake.h"
+
+//Every baked curve at one timestamp in one pass. A window of frames around
+//the playhead is copied out of the bakes frame by frame, so all tracks at
+//one time sit next to each other and two rows are blended with SSE or AVX
+//where the compiler targets them, one value at a time elsewhere. The window
+//moves with the playhead and is refilled when any of the bakes change.
+class DurationCurveBatch {
+  public:
+	DurationCurveBatch();
+
+	//the tracks to evaluate, all complete and sharing one interval and duration.
+	//returns true when the list differs from the last call
+	bool setup(const vector<DurationCurveBake*>& bakes);
+	int getNumColumns();
+
+	//every track at millis into values, one per column
+	void evaluate(unsigned long millis, float* values);
+	//the same without vector instructions, to check the vector path against
+	void evaluateScalar(unsigned long millis, float* values);
+
+	//largest difference between the vector and scalar paths at millis, and against
+	//the tracks themselves in liveDifference. times both over all columns
+	float compare(unsigned long millis, float& liveDifference, float& batchMicros, float& liveMicros);
+
+  protected:
+	vector<DurationCurveBake*> bakes;
+	vector<int> versions;
+
+	vector<float> window; //frame major, one row of columns per frame
+	int windowStart;
+	int windowFrames;
+	bool windowValid;
+
+	//the two rows around millis and how far between them it falls
+	void getRows(unsigned long millis, const float*& a, const float*& b, float& t);
+	void fillWindow(int frame);
+};
@@ -0,0 +1,267 @@
+/**
+ * Duration
+ * Standalone timeline for Creative Code
+ *
+ * Copyright (c) 2012 James George
+ * Development Supported by YCAM InterLab http://interlab.ycam.jp/en/
+ * http://jamesgeorge.org + http://flightphase.com
+ * http://github.com/obviousjim + http://github.com/flightphase
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include "DurationJournal.h"
+
+#define DURATION_JOURNAL_BUFFER 65536
+#define DURATION_JOURNAL_FLUSH_MILLIS 250
+
+static uint32_t journalChecksum(const char* data, size_t length){
+	uint32_t hash = 2166136261u;
+	for(size_t i = 0; i < length; i++){
+		hash = (hash ^ (uint8_t)data[i]) * 16777619u;
+	}
+	return hash;
+}
+
+static void journalPut(string& payload, const void* data, size_t length){
+	payload.append((const char*)data, length);
+}
+
+static bool journalGet(const string& payload, size_t& position, void* data, size_t length){
+	if(position + length > payload.size()){
+		return false;
+	}
+	memcpy(data, payload.data() + position, length);
+	position += length;
+	return true;
+}
+
+DurationJournal::DurationJournal(){
+	file = NULL;
+	size = 0;
+	unflushed = false;
+	rotated = false;
+	lastFlush = 0;
+}
+
+DurationJournal::~DurationJournal(){
+	close();
+}
+
+bool DurationJournal::open(string projectPath){
+	close();
+	mutex.lock();
+	path = ofToDataPath(projectPath + "/.durationjournal");
+	file = fopen(path.c_str(), "ab");
+	if(file == NULL){
+		ofLogError("DurationJournal::open") << "Could not open " << path << ", edits will not be journaled";
+	}
+	else{
+		setvbuf(file, NULL, _IOFBF, DURATION_JOURNAL_BUFFER);
+		fseek(file, 0, SEEK_END);
+		size = ftell(file);
+	}
+	rotated = ofFile::doesFileExist(path + ".old", false);
+	mutex.unlock();
+	return file != NULL;
+}
+
+void DurationJournal::close(){
+	mutex.lock();
+	if(file != NULL){
+		fclose(file);
+		file = NULL;
+	}
+	size = 0;
+	unflushed = false;
+	mutex.unlock();
+}
+
+void DurationJournal::addKey(const string& track, unsigned long millis, float value){
+	string payload;
+	uint8_t type = DURATION_JOURNAL_KEY;
+	uint16_t nameLength = track.size();
+	uint64_t time = millis;
+	journalPut(payload, &type, 1);
+	journalPut(payload, &nameLength, 2);
+	journalPut(payload, track.data(), nameLength);
+	journalPut(payload, &time, 8);
+	journalPut(payload, &value, 4);
+	add(payload);
+}
+
+void DurationJournal::addTrack(const string& track, const string& xml){
+	string payload;
+	uint8_t type = DURATION_JOURNAL_TRACK;
+	uint16_t nameLength = track.size();
+	uint32_t xmlLength = xml.size();
+	journalPut(payload, &type, 1);
+	journalPut(payload, &nameLength, 2);
+	journalPut(payload, track.data(), nameLength);
+	journalPut(payload, &xmlLength, 4);
+	journalPut(payload, xml.data(), xmlLength);
+	add(payload);
+}
+
+void DurationJournal::add(const string& payload){
+	uint32_t header[2] = { (uint32_t)payload.size(), journalChecksum(payload.data(), payload.size()) };
+	mutex.lock();
+	if(file != NULL){
+		fwrite(header, sizeof(header), 1, file);
+		fwrite(payload.data(), payload.size(), 1, file);
+		size += sizeof(header) + payload.size();
+		unflushed = true;
+	}
+	mutex.unlock();
+}
+
+void DurationJournal::flush(bool force){
+	mutex.lock();
+	unsigned long long now = ofGetElapsedTimeMillis();
+	if(file != NULL && unflushed && (force || now - lastFlush >= DURATION_JOURNAL_FLUSH_MILLIS)){
+		fflush(file);
+		unflushed = false;
+		lastFlush = now;
+	}
+	mutex.unlock();
+}
+
+void DurationJournal::rotate(){
+	mutex.lock();
+	if(file != NULL){
+		fclose(file);
+		//usually the journal just becomes the old one. an earlier save that isn't on disk
+		//yet still needs the old records, so then ours are copied in after them
+		string oldPath = path + ".old";
+		if(rotated || rename(path.c_str(), oldPath.c_str()) != 0){
+			FILE* old = fopen(oldPath.c_str(), "ab");
+			FILE* current = fopen(path.c_str(), "rb");
+			if(old != NULL && current != NULL){
+				char buffer[DURATION_JOURNAL_BUFFER];
+				size_t numRead;
+				while((numRead = fread(buffer, 1, sizeof(buffer), current)) > 0){
+					fwrite(buffer, 1, numRead, old);
+				}
+			}
+			if(current != NULL){
+				fclose(current);
+			}
+			if(old != NULL){
+				fclose(old);
+			}
+		}
+		file = fopen(path.c_str(), "wb");
+		if(file != NULL){
+			setvbuf(file, NULL, _IOFBF, DURATION_JOURNAL_BUFFER);
+		}
+		size = 0;
+		unflushed = false;
+		rotated = true;
+	}
+	mutex.unlock();
+}
+
+bool DurationJournal::hasRotated(){
+	mutex.lock();
+	bool hasOld = rotated;
+	mutex.unlock();
+	return hasOld;
+}
+
+void DurationJournal::removeRotated(){
+	mutex.lock();
+	remove((path + ".old").c_str());
+	rotated = false;
+	mutex.unlock();
+}
+
+size_t DurationJournal::getSize(){
+	mutex.lock();
+	size_t journaled = size;
+	mutex.unlock();
+	return journaled;
+}
+
+int DurationJournal::read(string projectPath, vector<DurationJournalRecord>& records){
+	records.clear();
+	string paths[2] = { ofToDataPath(projectPath + "/.durationjournal.old"), ofToDataPath(projectPath + "/.durationjournal") };
+	for(int p = 0; p < 2; p++){
+		ifstream in(paths[p].c_str(), ios::in | ios::binary);
+		if(!in.good()){
+			continue;
+		}
+		in.seekg(0, ios::end);
+		uint64_t fileSize = in.tellg();
+		in.seekg(0, ios::beg);
+		uint32_t header[2];
+		while(in.read((char*)header, sizeof(header))){
+			//a torn header can claim any length, it has to fit in what is left before it is read
+			bool fits = header[0] > 0 && header[0] <= fileSize - (uint64_t)in.tellg();
+			string payload(fits ? header[0] : 0, '\0');
+			if(!fits || !in.read(&payload[0], header[0]) || journalChecksum(payload.data(), payload.size()) != header[1]){
+				ofLogWarning("DurationJournal::read") << paths[p] << " ends in a record that was cut short, replaying up to it";
+				break;
+			}
+
+			DurationJournalRecord record;
+			size_t position = 0;
+			uint8_t type;
+			uint16_t nameLength;
+			journalGet(payload, position, &type, 1);
+			journalGet(payload, position, &nameLength, 2);
+			if(nameLength > payload.size() - position){
+				break;
+			}
+			record.track.resize(nameLength);
+			if(nameLength > 0 && !journalGet(payload, position, &record.track[0], nameLength)){
+				break;
+			}
+			record.type = (DurationJournalRecordType)type;
+			record.millis = 0;
+			record.value = 0;
+			if(record.type == DURATION_JOURNAL_KEY){
+				uint64_t time;
+				if(!journalGet(payload, position, &time, 8) || !journalGet(payload, position, &record.value, 4)){
+					break;
+				}
+				record.millis = time;
+			}
+			else if(record.type == DURATION_JOURNAL_TRACK){
+				uint32_t xmlLength;
+				if(!journalGet(payload, position, &xmlLength, 4) || xmlLength > payload.size() - position){
+					break;
+				}
+				record.xml.resize(xmlLength);
+				if(xmlLength > 0 && !journalGet(payload, position, &record.xml[0], xmlLength)){
+					break;
+				}
+			}
+			else{
+				continue;
+			}
+			records.push_back(record);
+		}
+	}
+	return records.size();
+}
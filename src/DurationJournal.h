@@ -0,0 +1,91 @@
+/**
+ * Duration
+ * Standalone timeline for Creative Code
+ *
+ * Copyright (c) 2012 James George
+ * Development Supported by YCAM InterLab http://interlab.ycam.jp/en/
+ * http://jamesgeorge.org + http://flightphase.com
+ * http://github.com/obviousjim + http://github.com/flightphase
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#pragma once
+
+#include "ofMain.h"
+
+typedef enum {
+	DURATION_JOURNAL_KEY, //one keyframe recorded from OSC
+	DURATION_JOURNAL_TRACK //a track's whole XML after an edit in the timeline
+} DurationJournalRecordType;
+
+typedef struct {
+	DurationJournalRecordType type;
+	string track;
+	unsigned long millis;
+	float value;
+	string xml;
+} DurationJournalRecord;
+
+//Edits made since the last save, appended to .durationjournal in the project
+//folder so a crash loses at most the records still in the write buffer. A
+//save starts a new journal and keeps the previous one as .durationjournal.old
+//until the save is on disk. Each record carries its length and a checksum,
+//reading stops at the first one that was cut short.
+class DurationJournal {
+  public:
+	DurationJournal();
+	~DurationJournal();
+
+	//appends to the project's journal, keeping what is already in it
+	bool open(string projectPath);
+	void close();
+
+	void addKey(const string& track, unsigned long millis, float value);
+	void addTrack(const string& track, const string& xml);
+	//hands buffered records to the system, at most every few hundred millis unless forced
+	void flush(bool force = false);
+
+	//called when a save is copied, what follows goes to a fresh journal
+	void rotate();
+	bool hasRotated();
+	//the save that rotated is on disk, its journal can go
+	void removeRotated();
+	//bytes journaled since the last rotation
+	size_t getSize();
+
+	//records of a session that ended before saving them, oldest first
+	static int read(string projectPath, vector<DurationJournalRecord>& records);
+
+  protected:
+	ofMutex mutex;
+	FILE* file;
+	string path;
+	size_t size;
+	bool unflushed;
+	bool rotated;
+	unsigned long long lastFlush;
+
+	void add(const string& payload);
+};
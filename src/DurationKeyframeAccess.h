@@ -0,0 +1,94 @@
+/**
+ * Duration
+ * Standalone timeline for Creative Code
+ *
+ * Copyright (c) 2012 James George
+ * Development Supported by YCAM InterLab http://interlab.ycam.jp/en/
+ * http://jamesgeorge.org + http://flightphase.com
+ * http://github.com/obviousjim + http://github.com/flightphase
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#pragma once
+
+#include "ofMain.h"
+#include "ofxTimeline.h"
+
+//ofxTLKeyframes and ofxTLCurves keep their keys and tweening protected. These
+//reach them through member pointers taken from a subclass, which is how we
+//sample, store and restore keys without going through the XML representation.
+class DurationKeyframeAccess : public ofxTLKeyframes {
+  public:
+	static vector<ofxTLKeyframe*>& getKeyframes(ofxTLKeyframes* track){
+		return track->*(&DurationKeyframeAccess::keyframes);
+	}
+	static float interpolate(ofxTLKeyframes* track, ofxTLKeyframe* start, ofxTLKeyframe* end, unsigned long millis){
+		return (track->*(&DurationKeyframeAccess::interpolateValueForKeys))(start, end, millis);
+	}
+	//a key of the track's own type, with its defaults
+	static ofxTLKeyframe* createKeyframe(ofxTLKeyframes* track){
+		return (track->*(&DurationKeyframeAccess::newKeyframe))();
+	}
+	static void sortKeyframes(ofxTLKeyframes* track){
+		(track->*(&DurationKeyframeAccess::updateKeyframeSort))();
+	}
+	//keys of the track's type read from a track file into keys, leaving the track's own alone
+	static void readKeyframes(ofxTLKeyframes* track, ofxXmlSettings& xml, vector<ofxTLKeyframe*>& keys){
+		(track->*(&DurationKeyframeAccess::createKeyframesFromXML))(xml, keys);
+	}
+	//hash of every key's time and value, and easing on curves. other data a key
+	//carries, like flag text, is not covered
+	static unsigned long long getFingerprint(ofxTLKeyframes* track){
+		vector<ofxTLKeyframe*>& keys = getKeyframes(track);
+		bool curves = track->getTrackType() == "Curves";
+		unsigned long long hash = 14695981039346656037ULL;
+		for(int i = 0; i < keys.size(); i++){
+			unsigned long long fields[3] = { (unsigned long long)keys[i]->time, 0, 0 };
+			memcpy(&fields[1], &keys[i]->value, sizeof(float));
+			if(curves){
+				ofxTLTweenKeyframe* tween = (ofxTLTweenKeyframe*)keys[i];
+				fields[2] = tween->easeFunc->id << 8 | tween->easeType->id;
+			}
+			for(int f = 0; f < 3; f++){
+				hash = (hash ^ fields[f]) * 1099511628211ULL;
+			}
+		}
+		return (hash ^ keys.size()) * 1099511628211ULL;
+	}
+	//the XML the track's save() writes to its file
+	static string getXMLString(ofxTLKeyframes* track){
+		return (track->*(&DurationKeyframeAccess::getXMLStringForKeyframes))(getKeyframes(track));
+	}
+};
+
+class DurationCurvesAccess : public ofxTLCurves {
+  public:
+	static vector<EasingFunction*>& getEasingFunctions(ofxTLCurves* curves){
+		return curves->*(&DurationCurvesAccess::easingFunctions);
+	}
+	static vector<EasingType*>& getEasingTypes(ofxTLCurves* curves){
+		return curves->*(&DurationCurvesAccess::easingTypes);
+	}
+};
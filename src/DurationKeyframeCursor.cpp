@@ -0,0 +1,107 @@
+/**
+ * Duration
+ * Standalone timeline for Creative Code
+ *
+ * Copyright (c) 2012 James George
+ * Development Supported by YCAM InterLab http://interlab.ycam.jp/en/
+ * http://jamesgeorge.org + http://flightphase.com
+ * http://github.com/obviousjim + http://github.com/flightphase
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include "DurationKeyframeCursor.h"
+#include "DurationKeyframeAccess.h"
+
+#define DURATION_CURSOR_MAX_STEPS 4 //segments walked forward before searching
+
+DurationKeyframeCursor::DurationKeyframeCursor(){
+	track = NULL;
+	useCursor = false;
+	segment = 1;
+	numSearches = 0;
+}
+
+void DurationKeyframeCursor::setup(ofxTLKeyframes* cursorTrack, bool cursor){
+	track = cursorTrack;
+	useCursor = cursor;
+	segment = 1;
+}
+
+float DurationKeyframeCursor::getValueAtTimeInMillis(unsigned long millis, unsigned long duration){
+	vector<ofxTLKeyframe*>& keyframes = DurationKeyframeAccess::getKeyframes(track);
+	if(!useCursor || keyframes.size() < 2){
+		return track->getValueAtTimeInMillis(millis);
+	}
+
+	//same edge cases as ofxTLKeyframes::sampleAtTime
+	millis = MIN(millis, duration);
+	float value;
+	if(millis <= keyframes[0]->time){
+		value = keyframes[0]->value;
+	}
+	else if(millis >= keyframes.back()->time){
+		value = keyframes.back()->value;
+	}
+	else{
+		segment = findSegment(keyframes, millis);
+		value = DurationKeyframeAccess::interpolate(track, keyframes[segment-1], keyframes[segment], millis);
+	}
+	return ofMap(value, 0, 1, track->getValueRange().min, track->getValueRange().max, true);
+}
+
+int DurationKeyframeCursor::getNumSearches(){
+	return numSearches;
+}
+
+void DurationKeyframeCursor::resetSearches(){
+	numSearches = 0;
+}
+
+//first key at or after millis, which lies strictly inside the keys
+int DurationKeyframeCursor::findSegment(vector<ofxTLKeyframe*>& keyframes, unsigned long millis){
+	int last = keyframes.size() - 1;
+	int s = MIN(MAX(segment, 1), last);
+	if(keyframes[s-1]->time < millis){
+		for(int i = 0; i < DURATION_CURSOR_MAX_STEPS && s <= last; i++, s++){
+			if(keyframes[s]->time >= millis){
+				return s;
+			}
+		}
+	}
+
+	numSearches++;
+	int low = 1;
+	int high = last;
+	while(low < high){
+		int mid = (low + high) / 2;
+		if(keyframes[mid]->time >= millis){
+			high = mid;
+		}
+		else{
+			low = mid + 1;
+		}
+	}
+	return low;
+}
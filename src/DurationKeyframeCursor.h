@@ -0,0 +1,62 @@
+/**
+ * Duration
+ * Standalone timeline for Creative Code
+ *
+ * Copyright (c) 2012 James George
+ * Development Supported by YCAM InterLab http://interlab.ycam.jp/en/
+ * http://jamesgeorge.org + http://flightphase.com
+ * http://github.com/obviousjim + http://github.com/flightphase
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#pragma once
+
+#include "ofMain.h"
+#include "ofxTimeline.h"
+
+//Samples a Curves track like getValueAtTimeInMillis, remembering the segment
+//the last sample fell in. Playback moves forward one output period at a time,
+//so the next sample is nearly always in the same segment or a few after it;
+//seeks, loops and edits that move the time outside the nearby segments fall
+//back to a binary search instead of the timeline's walk from the first key.
+class DurationKeyframeCursor {
+  public:
+	DurationKeyframeCursor();
+
+	//LFO tracks evaluate their keys differently and are always sampled by the track
+	void setup(ofxTLKeyframes* track, bool useCursor);
+	float getValueAtTimeInMillis(unsigned long millis, unsigned long duration);
+
+	int getNumSearches(); //binary searches since the last reset
+	void resetSearches();
+
+  protected:
+	ofxTLKeyframes* track;
+	bool useCursor;
+	int segment; //index of the key that ends the segment last sampled
+	int numSearches;
+
+	int findSegment(vector<ofxTLKeyframe*>& keyframes, unsigned long millis);
+};
@@ -0,0 +1,142 @@
+/**
+ * Duration
+ * Standalone timeline for Creative Code
+ *
+ * Copyright (c) 2012 James George
+ * Development Supported by YCAM InterLab http://interlab.ycam.jp/en/
+ * http://jamesgeorge.org + http://flightphase.com
+ * http://github.com/obviousjim + http://github.com/flightphase
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include "DurationKeyframeParser.h"
+#include "DurationKeyframeAccess.h"
+#include <thread>
+
+class DurationKeyframeParserThread : public ofThread {
+  public:
+	DurationKeyframeParser* parser;
+	void threadedFunction(){
+		parser->parseTracks();
+	}
+};
+
+DurationKeyframeParser::DurationKeyframeParser(){
+	nextTrack = 0;
+	numThreads = 0;
+	parseMicros = 0;
+}
+
+DurationKeyframeParser::~DurationKeyframeParser(){
+	//keys never inserted belong to nobody
+	for(int i = 0; i < tracks.size(); i++){
+		for(int k = 0; k < tracks[i].keyframes.size(); k++){
+			delete tracks[i].keyframes[k];
+		}
+	}
+}
+
+bool DurationKeyframeParser::canParse(string trackType){
+	return trackType == "Curves" || trackType == "Bangs";
+}
+
+void DurationKeyframeParser::add(ofxTLKeyframes* track, string path){
+	DurationParsedTrack parsed;
+	parsed.track = track;
+	parsed.path = path;
+	tracks.push_back(parsed);
+}
+
+void DurationKeyframeParser::parse(int threads){
+	nextTrack = 0;
+	parseMicros = 0;
+	numThreads = MAX(1, MIN(threads, (int)tracks.size()));
+
+	vector< ofPtr<DurationKeyframeParserThread> > workers;
+	for(int i = 1; i < numThreads; i++){
+		ofPtr<DurationKeyframeParserThread> worker(new DurationKeyframeParserThread());
+		worker->parser = this;
+		worker->startThread(false, false);
+		workers.push_back(worker);
+	}
+	parseTracks();
+	for(int i = 0; i < workers.size(); i++){
+		workers[i]->waitForThread(false);
+	}
+}
+
+void DurationKeyframeParser::parseTracks(){
+	while(true){
+		mutex.lock();
+		int index = nextTrack++;
+		mutex.unlock();
+		if(index >= tracks.size()){
+			return;
+		}
+
+		unsigned long long start = ofGetElapsedTimeMicros();
+		DurationParsedTrack& parsed = tracks[index];
+		ofxXmlSettings xml;
+		if(xml.loadFile(parsed.path)){
+			DurationKeyframeAccess::readKeyframes(parsed.track, xml, parsed.keyframes);
+		}
+		unsigned long long micros = ofGetElapsedTimeMicros() - start;
+
+		mutex.lock();
+		parseMicros += micros;
+		mutex.unlock();
+	}
+}
+
+int DurationKeyframeParser::insert(){
+	int numKeyframes = 0;
+	for(int i = 0; i < tracks.size(); i++){
+		vector<ofxTLKeyframe*>& keyframes = DurationKeyframeAccess::getKeyframes(tracks[i].track);
+		for(int k = 0; k < keyframes.size(); k++){
+			delete keyframes[k];
+		}
+		keyframes.clear();
+		keyframes.swap(tracks[i].keyframes);
+		DurationKeyframeAccess::sortKeyframes(tracks[i].track);
+		numKeyframes += keyframes.size();
+	}
+	return numKeyframes;
+}
+
+int DurationKeyframeParser::getNumTracks(){
+	return tracks.size();
+}
+
+int DurationKeyframeParser::getNumThreads(){
+	return numThreads;
+}
+
+float DurationKeyframeParser::getParseMillis(){
+	return parseMicros / 1000.;
+}
+
+int DurationKeyframeParser::getDefaultNumThreads(){
+	return MAX(1, (int)std::thread::hardware_concurrency());
+}
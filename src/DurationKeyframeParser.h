@@ -0,0 +1,81 @@
+/**
+ * Duration
+ * Standalone timeline for Creative Code
+ *
+ * Copyright (c) 2012 James George
+ * Development Supported by YCAM InterLab http://interlab.ycam.jp/en/
+ * http://jamesgeorge.org + http://flightphase.com
+ * http://github.com/obviousjim + http://github.com/flightphase
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#pragma once
+
+#include "ofMain.h"
+#include "ofxTimeline.h"
+#include "ofxXmlSettings.h"
+
+typedef struct {
+	ofxTLKeyframes* track;
+	string path;
+	vector<ofxTLKeyframe*> keyframes; //parsed, not yet in the track
+} DurationParsedTrack;
+
+//Parses the XML files of several tracks at once on a pool of threads. The
+//keys are made by each file's own track but held on the side, insert() then
+//hands them to the tracks from the thread that owns the timeline. Only curves
+//and bangs are parsed this way, other key types set up text fields and
+//palettes that aren't safe to touch off the main thread.
+class DurationKeyframeParser {
+  public:
+	DurationKeyframeParser();
+	~DurationKeyframeParser();
+
+	static bool canParse(string trackType);
+
+	void add(ofxTLKeyframes* track, string path);
+	//parses everything added, returns when all of it is done. the calling thread
+	//works too, so one thread parses in place
+	void parse(int numThreads);
+	//replaces the tracks' keys with the parsed ones, returns the number of keys
+	int insert();
+
+	int getNumTracks();
+	int getNumThreads(); //used by the last parse
+	float getParseMillis(); //summed over all threads, to compare against the wall clock
+
+	//what the hardware runs at once, at least one
+	static int getDefaultNumThreads();
+
+  protected:
+	friend class DurationKeyframeParserThread;
+	void parseTracks();
+
+	vector<DurationParsedTrack> tracks;
+	ofMutex mutex;
+	int nextTrack;
+	int numThreads;
+	unsigned long long parseMicros;
+};
@@ -0,0 +1,324 @@
+/**
+ * Duration
+ * Standalone timeline for Creative Code
+ *
+ * Copyright (c) 2012 James George
+ * Development Supported by YCAM InterLab http://interlab.ycam.jp/en/
+ * http://jamesgeorge.org + http://flightphase.com
+ * http://github.com/obviousjim + http://github.com/flightphase
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include "DurationKeyframeStore.h"
+#include "DurationKeyframeAccess.h"
+#include <sys/stat.h>
+#ifndef TARGET_WIN32
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#define DURATION_STORE_VERSION 1
+
+enum {
+	DURATION_STORE_CURVES = 0,
+	DURATION_STORE_BANGS = 1
+};
+
+typedef struct {
+	char magic[4];
+	uint32_t version;
+	uint32_t numTracks;
+	uint32_t namesSize;
+} DurationStoreHeader;
+
+static uint64_t alignStore(uint64_t offset){
+	return (offset + 7) & ~(uint64_t)7;
+}
+
+DurationKeyframeStore::DurationKeyframeStore(){
+	data = NULL;
+	size = 0;
+#ifdef TARGET_WIN32
+	mapping = NULL;
+#endif
+	modifiedTime = 0;
+}
+
+DurationKeyframeStore::~DurationKeyframeStore(){
+	close();
+}
+
+int DurationKeyframeStore::build(ofxTimeline& timeline, string& contents){
+	vector<ofxTLKeyframes*> tracks;
+	vector<uint32_t> types;
+	vector<ofxTLPage*>& pages = timeline.getPages();
+	for(int i = 0; i < pages.size(); i++){
+		vector<ofxTLTrack*>& pageTracks = pages[i]->getTracks();
+		for(int t = 0; t < pageTracks.size(); t++){
+			string trackType = pageTracks[t]->getTrackType();
+			if(trackType == "Curves"){
+				types.push_back(DURATION_STORE_CURVES);
+			}
+			else if(trackType == "Bangs"){
+				types.push_back(DURATION_STORE_BANGS);
+			}
+			else{
+				continue;
+			}
+			tracks.push_back((ofxTLKeyframes*)pageTracks[t]);
+		}
+	}
+
+	//lay out the whole file before writing any of it
+	DurationStoreHeader header;
+	memcpy(header.magic, "DURK", 4);
+	header.version = DURATION_STORE_VERSION;
+	header.numTracks = tracks.size();
+	string names;
+	vector<Entry> fileEntries(tracks.size());
+	for(int i = 0; i < tracks.size(); i++){
+		fileEntries[i].nameOffset = names.size();
+		fileEntries[i].nameLength = tracks[i]->getName().size();
+		fileEntries[i].type = types[i];
+		fileEntries[i].numKeyframes = DurationKeyframeAccess::getKeyframes(tracks[i]).size();
+		names += tracks[i]->getName();
+	}
+	header.namesSize = names.size();
+
+	uint64_t offset = alignStore(sizeof(DurationStoreHeader) + sizeof(Entry) * fileEntries.size() + names.size());
+	for(int i = 0; i < fileEntries.size(); i++){
+		uint64_t numKeyframes = fileEntries[i].numKeyframes;
+		fileEntries[i].timesOffset = offset;
+		offset = alignStore(offset + numKeyframes * sizeof(uint64_t));
+		fileEntries[i].valuesOffset = offset;
+		offset = alignStore(offset + numKeyframes * sizeof(float));
+		fileEntries[i].easingOffset = offset;
+		if(fileEntries[i].type == DURATION_STORE_CURVES){
+			offset = alignStore(offset + numKeyframes * 2);
+		}
+	}
+
+	//arrays are copied straight into place, the gaps stay zero for alignment
+	contents.assign(offset, '\0');
+	char* buffer = &contents[0];
+	memcpy(buffer, &header, sizeof(header));
+	if(!fileEntries.empty()){
+		memcpy(buffer + sizeof(header), &fileEntries[0], sizeof(Entry) * fileEntries.size());
+	}
+	memcpy(buffer + sizeof(header) + sizeof(Entry) * fileEntries.size(), names.data(), names.size());
+
+	int numWritten = 0;
+	for(int i = 0; i < tracks.size(); i++){
+		vector<ofxTLKeyframe*>& keyframes = DurationKeyframeAccess::getKeyframes(tracks[i]);
+		uint64_t* times = (uint64_t*)(buffer + fileEntries[i].timesOffset);
+		float* values = (float*)(buffer + fileEntries[i].valuesOffset);
+		uint8_t* easing = (uint8_t*)(buffer + fileEntries[i].easingOffset);
+		int numKeyframes = keyframes.size();
+		for(int k = 0; k < numKeyframes; k++){
+			times[k] = keyframes[k]->time;
+			values[k] = keyframes[k]->value;
+		}
+		if(fileEntries[i].type == DURATION_STORE_CURVES){
+			for(int k = 0; k < numKeyframes; k++){
+				ofxTLTweenKeyframe* tween = (ofxTLTweenKeyframe*)keyframes[k];
+				easing[k*2]   = tween->easeFunc->id;
+				easing[k*2+1] = tween->easeType->id;
+			}
+		}
+		numWritten += numKeyframes;
+	}
+	return numWritten;
+}
+
+bool DurationKeyframeStore::open(string path){
+	close();
+	path = ofToDataPath(path);
+
+	struct stat info;
+	if(stat(path.c_str(), &info) != 0){
+		return false;
+	}
+	modifiedTime = info.st_mtime;
+	size = info.st_size;
+	if(size < sizeof(DurationStoreHeader)){
+		ofLogError("DurationKeyframeStore::open") << path << " is too short to be a keyframe store";
+		size = 0;
+		return false;
+	}
+
+#ifdef TARGET_WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if(file == INVALID_HANDLE_VALUE){
+		return false;
+	}
+	mapping = CreateFileMapping(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	CloseHandle(file);
+	if(mapping == NULL){
+		return false;
+	}
+	data = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+#else
+	int file = ::open(path.c_str(), O_RDONLY);
+	if(file < 0){
+		return false;
+	}
+	void* mapped = mmap(NULL, size, PROT_READ, MAP_PRIVATE, file, 0);
+	::close(file);
+	data = mapped == MAP_FAILED ? NULL : (const char*)mapped;
+#endif
+	if(data == NULL){
+		ofLogError("DurationKeyframeStore::open") << "Could not map " << path;
+		close();
+		return false;
+	}
+
+	const DurationStoreHeader* header = (const DurationStoreHeader*)data;
+	if(memcmp(header->magic, "DURK", 4) != 0 || header->version > DURATION_STORE_VERSION){
+		ofLogError("DurationKeyframeStore::open") << path << " is not a keyframe store this version can read";
+		close();
+		return false;
+	}
+
+	//every array has to lie inside the file before anything reads it
+	const Entry* fileEntries = (const Entry*)(data + sizeof(DurationStoreHeader));
+	const char* names = (const char*)(fileEntries + header->numTracks);
+	if((uint64_t)header->numTracks * sizeof(Entry) + header->namesSize > size - sizeof(DurationStoreHeader)){
+		ofLogError("DurationKeyframeStore::open") << path << " is truncated";
+		close();
+		return false;
+	}
+	for(int i = 0; i < header->numTracks; i++){
+		const Entry& entry = fileEntries[i];
+		uint64_t numKeyframes = entry.numKeyframes;
+		if((uint64_t)entry.nameOffset + entry.nameLength > header->namesSize ||
+		   entry.timesOffset + numKeyframes * sizeof(uint64_t) > size ||
+		   entry.valuesOffset + numKeyframes * sizeof(float) > size ||
+		   (entry.type == DURATION_STORE_CURVES && entry.easingOffset + numKeyframes * 2 > size))
+		{
+			ofLogError("DurationKeyframeStore::open") << path << " is truncated";
+			close();
+			return false;
+		}
+		entries[string(names + entry.nameOffset, entry.nameLength)] = &entry;
+	}
+	return true;
+}
+
+void DurationKeyframeStore::close(){
+	if(data != NULL){
+#ifdef TARGET_WIN32
+		UnmapViewOfFile(data);
+#else
+		munmap((void*)data, size);
+#endif
+	}
+#ifdef TARGET_WIN32
+	if(mapping != NULL){
+		CloseHandle(mapping);
+		mapping = NULL;
+	}
+#endif
+	data = NULL;
+	size = 0;
+	entries.clear();
+}
+
+bool DurationKeyframeStore::isOpen(){
+	return data != NULL;
+}
+
+bool DurationKeyframeStore::isCurrentFor(string path){
+	struct stat info;
+	if(stat(ofToDataPath(path).c_str(), &info) != 0){
+		return true;
+	}
+	//times are in whole seconds, so a file saved in the same second as the store may be newer
+	return info.st_mtime < modifiedTime;
+}
+
+bool DurationKeyframeStore::hasTrack(string name){
+	return entries.find(name) != entries.end();
+}
+
+int DurationKeyframeStore::load(ofxTLKeyframes* track){
+	map<string, const Entry*>::iterator it = entries.find(track->getName());
+	if(it == entries.end()){
+		return -1;
+	}
+	const Entry& entry = *it->second;
+	string trackType = track->getTrackType();
+	if((entry.type == DURATION_STORE_CURVES && trackType != "Curves") ||
+	   (entry.type == DURATION_STORE_BANGS && trackType != "Bangs"))
+	{
+		ofLogError("DurationKeyframeStore::load") << track->getName() << " is stored as a different type of track";
+		return -1;
+	}
+
+	vector<ofxTLKeyframe*>& keyframes = DurationKeyframeAccess::getKeyframes(track);
+	for(int i = 0; i < keyframes.size(); i++){
+		delete keyframes[i];
+	}
+	keyframes.clear();
+
+	const uint64_t* times = (const uint64_t*)(data + entry.timesOffset);
+	const float* values = (const float*)(data + entry.valuesOffset);
+	const uint8_t* easing = (const uint8_t*)(data + entry.easingOffset);
+	keyframes.reserve(entry.numKeyframes);
+	for(int k = 0; k < entry.numKeyframes; k++){
+		ofxTLKeyframe* key = DurationKeyframeAccess::createKeyframe(track);
+		key->time = times[k];
+		key->value = values[k];
+		keyframes.push_back(key);
+	}
+	if(entry.type == DURATION_STORE_CURVES){
+		vector<EasingFunction*>& functions = DurationCurvesAccess::getEasingFunctions((ofxTLCurves*)track);
+		vector<EasingType*>& types = DurationCurvesAccess::getEasingTypes((ofxTLCurves*)track);
+		//the store holds ids, which needn't match the position in the list
+		EasingFunction* functionsById[256] = {};
+		EasingType* typesById[256] = {};
+		for(int i = 0; i < functions.size(); i++){
+			if(functions[i]->id >= 0 && functions[i]->id < 256){
+				functionsById[functions[i]->id] = functions[i];
+			}
+		}
+		for(int i = 0; i < types.size(); i++){
+			if(types[i]->id >= 0 && types[i]->id < 256){
+				typesById[types[i]->id] = types[i];
+			}
+		}
+		for(int k = 0; k < entry.numKeyframes; k++){
+			ofxTLTweenKeyframe* tween = (ofxTLTweenKeyframe*)keyframes[k];
+			if(functionsById[easing[k*2]] != NULL){
+				tween->easeFunc = functionsById[easing[k*2]];
+			}
+			if(typesById[easing[k*2+1]] != NULL){
+				tween->easeType = typesById[easing[k*2+1]];
+			}
+		}
+	}
+	DurationKeyframeAccess::sortKeyframes(track);
+	return entry.numKeyframes;
+}
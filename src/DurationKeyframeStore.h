@@ -0,0 +1,90 @@
+/**
+ * Duration
+ * Standalone timeline for Creative Code
+ *
+ * Copyright (c) 2012 James George
+ * Development Supported by YCAM InterLab http://interlab.ycam.jp/en/
+ * http://jamesgeorge.org + http://flightphase.com
+ * http://github.com/obviousjim + http://github.com/flightphase
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#pragma once
+
+#include "ofMain.h"
+#include "ofxTimeline.h"
+
+//Keyframes of every Curves and Bangs track in one binary file next to the
+//project, so opening a show maps one file instead of parsing an XML file per
+//track. The XML files are still written on every save and stay the fallback:
+//other track types, tracks missing from the store and tracks whose XML is
+//newer than the store load from XML as before.
+//
+//Layout, little endian:
+//  header   "DURK", version, track count, size of the name table
+//  entries  one per track: name offset and length, type, key count, array offsets
+//  names    track names, not terminated
+//  arrays   per track, 8 byte aligned: uint64 times, float values, and for
+//           curves a pair of easing function and type ids per key
+class DurationKeyframeStore {
+  public:
+	DurationKeyframeStore();
+	~DurationKeyframeStore();
+
+	//lays out the store for every Curves and Bangs track on the timeline into contents,
+	//returns the number of keys in it
+	static int build(ofxTimeline& timeline, string& contents);
+
+	//maps the file and checks its header and entries
+	bool open(string path);
+	void close();
+	bool isOpen();
+	//false when the file at path was written after the store or in the same second,
+	//so it should be read instead
+	bool isCurrentFor(string path);
+
+	bool hasTrack(string name);
+	//replaces the track's keys with the stored ones, returns the number of keys or -1
+	int load(ofxTLKeyframes* track);
+
+  protected:
+	typedef struct {
+		uint32_t nameOffset;
+		uint32_t nameLength;
+		uint32_t type;
+		uint32_t numKeyframes;
+		uint64_t timesOffset;
+		uint64_t valuesOffset;
+		uint64_t easingOffset;
+	} Entry;
+
+	const char* data;
+	size_t size;
+#ifdef TARGET_WIN32
+	HANDLE mapping;
+#endif
+	time_t modifiedTime;
+	map<string, const Entry*> entries;
+};
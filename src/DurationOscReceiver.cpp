@@ -0,0 +1,216 @@
+/**
+ * Duration
+ * Standalone timeline for Creative Code
+ *
+ * Copyright (c) 2012 James George
+ * Development Supported by YCAM InterLab http://interlab.ycam.jp/en/
+ * http://jamesgeorge.org + http://flightphase.com
+ * http://github.com/obviousjim + http://github.com/flightphase
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include "DurationOscReceiver.h"
+#include "DurationOscWriter.h"
+
+DurationOscReceiver::DurationOscReceiver(int capacity){
+	socket = NULL;
+	wakeup = NULL;
+
+	//round up to a power of two so wrapping is a mask
+	size_t size = 1;
+	while(size < (size_t)capacity){
+		size <<= 1;
+	}
+	ring.resize(size);
+	mask = size - 1;
+
+	head = 0;
+	tail = 0;
+	dropped = 0;
+	resetTimetagStats();
+}
+
+DurationOscReceiver::~DurationOscReceiver(){
+	close();
+}
+
+void DurationOscReceiver::setup(int port){
+	close();
+	try{
+		socket = new UdpListeningReceiveSocket(IpEndpointName(IpEndpointName::ANY_ADDRESS, port), this);
+	}
+	catch(std::exception& e){
+		ofLogError("DurationOscReceiver::setup") << "could not listen on port " << port << ": " << e.what();
+		socket = NULL;
+		return;
+	}
+	startThread();
+}
+
+void DurationOscReceiver::close(){
+	if(socket != NULL){
+		socket->AsynchronousBreak();
+		waitForThread(true);
+		delete socket;
+		socket = NULL;
+	}
+}
+
+void DurationOscReceiver::setWakeup(DurationWakeup* _wakeup){
+	wakeup = _wakeup;
+}
+
+void DurationOscReceiver::threadedFunction(){
+	//blocks in select() until packets arrive or AsynchronousBreak is called
+	socket->Run();
+}
+
+void DurationOscReceiver::ProcessBundle(const osc::ReceivedBundle& b, const IpEndpointName& remoteEndpoint){
+	//a time tag of 1 means immediately
+	if(b.TimeTag() != 1){
+		double margin = DurationOscWriter::getMicrosUntil(b.TimeTag()) / 1000.;
+		statsMutex.lock();
+		if(scheduledBundles == 0 || margin < marginMin){
+			marginMin = margin;
+		}
+		if(scheduledBundles == 0 || margin > marginMax){
+			marginMax = margin;
+		}
+		marginSum += margin;
+		marginSquaredSum += margin * margin;
+		scheduledBundles++;
+		if(margin < 0){
+			lateBundles++;
+		}
+		statsMutex.unlock();
+	}
+	osc::OscPacketListener::ProcessBundle(b, remoteEndpoint);
+}
+
+int DurationOscReceiver::getScheduledBundles(){
+	statsMutex.lock();
+	int bundles = scheduledBundles;
+	statsMutex.unlock();
+	return bundles;
+}
+
+int DurationOscReceiver::getLateBundles(){
+	statsMutex.lock();
+	int late = lateBundles;
+	statsMutex.unlock();
+	return late;
+}
+
+float DurationOscReceiver::getMinMarginMillis(){
+	statsMutex.lock();
+	float margin = marginMin;
+	statsMutex.unlock();
+	return margin;
+}
+
+float DurationOscReceiver::getMaxMarginMillis(){
+	statsMutex.lock();
+	float margin = marginMax;
+	statsMutex.unlock();
+	return margin;
+}
+
+float DurationOscReceiver::getMarginDeviationMillis(){
+	statsMutex.lock();
+	double deviation = 0;
+	if(scheduledBundles > 0){
+		double mean = marginSum / scheduledBundles;
+		deviation = sqrt(MAX(marginSquaredSum / scheduledBundles - mean * mean, 0.));
+	}
+	statsMutex.unlock();
+	return deviation;
+}
+
+void DurationOscReceiver::resetTimetagStats(){
+	statsMutex.lock();
+	scheduledBundles = 0;
+	lateBundles = 0;
+	marginMin = 0;
+	marginMax = 0;
+	marginSum = 0;
+	marginSquaredSum = 0;
+	statsMutex.unlock();
+}
+
+void DurationOscReceiver::ProcessMessage(const osc::ReceivedMessage& m, const IpEndpointName& remoteEndpoint){
+	size_t currentHead = head.load(std::memory_order_relaxed);
+	if(currentHead - tail.load(std::memory_order_acquire) > mask){
+		dropped++;
+		return;
+	}
+
+	ofxOscMessage& slot = ring[currentHead & mask];
+	slot.clear();
+	slot.setAddress(m.AddressPattern());
+	for(osc::ReceivedMessage::const_iterator arg = m.ArgumentsBegin(); arg != m.ArgumentsEnd(); ++arg){
+		if(arg->IsInt32()){
+			slot.addIntArg(arg->AsInt32Unchecked());
+		}
+		else if(arg->IsInt64()){
+			slot.addInt64Arg(arg->AsInt64Unchecked());
+		}
+		else if(arg->IsFloat()){
+			slot.addFloatArg(arg->AsFloatUnchecked());
+		}
+		else if(arg->IsString()){
+			slot.addStringArg(arg->AsStringUnchecked());
+		}
+		else{
+			ofLogError("DurationOscReceiver") << "argument in message " << m.AddressPattern() << " is not an int, float, or string";
+		}
+	}
+
+	head.store(currentHead + 1, std::memory_order_release);
+	if(wakeup != NULL){
+		wakeup->notify();
+	}
+}
+
+bool DurationOscReceiver::hasWaitingMessages(){
+	return tail.load(std::memory_order_relaxed) != head.load(std::memory_order_acquire);
+}
+
+bool DurationOscReceiver::getNextMessage(ofxOscMessage* message){
+	size_t currentTail = tail.load(std::memory_order_relaxed);
+	if(currentTail == head.load(std::memory_order_acquire)){
+		return false;
+	}
+	*message = ring[currentTail & mask];
+	tail.store(currentTail + 1, std::memory_order_release);
+	return true;
+}
+
+void DurationOscReceiver::clear(){
+	tail.store(head.load(std::memory_order_acquire), std::memory_order_release);
+}
+
+unsigned long DurationOscReceiver::getDroppedMessages(){
+	return dropped;
+}
@@ -0,0 +1,96 @@
+/**
+ * Duration
+ * Standalone timeline for Creative Code
+ *
+ * Copyright (c) 2012 James George
+ * Development Supported by YCAM InterLab http://interlab.ycam.jp/en/
+ * http://jamesgeorge.org + http://flightphase.com
+ * http://github.com/obviousjim + http://github.com/flightphase
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include "ofMain.h"
+#include "ofxOsc.h"
+#include "OscPacketListener.h"
+#include "UdpSocket.h"
+#include "DurationWakeup.h"
+
+#include <atomic>
+
+//Listens on its own thread and decodes into a fixed size ring of messages.
+//One thread receives, one thread applies; neither locks. The slots are
+//ofxOscMessages, so their arguments are still allocated as they are decoded
+//and getNextMessage copies the message out.
+class DurationOscReceiver : public ofThread, public osc::OscPacketListener {
+  public:
+	DurationOscReceiver(int capacity = 4096);
+	~DurationOscReceiver();
+
+	void setup(int port);
+	void close();
+
+	//notified every time a message is queued
+	void setWakeup(DurationWakeup* wakeup);
+
+	//consumer side, only call from the thread applying messages
+	bool hasWaitingMessages();
+	bool getNextMessage(ofxOscMessage* message);
+	void clear();
+
+	//messages thrown away because the ring was full, since it was created
+	unsigned long getDroppedMessages();
+
+	//how far ahead of their time tag scheduled bundles arrive. the spread is the
+	//jitter a sender's lookahead has to absorb, late bundles were not absorbed
+	int getScheduledBundles();
+	int getLateBundles();
+	float getMinMarginMillis();
+	float getMaxMarginMillis();
+	float getMarginDeviationMillis();
+	void resetTimetagStats();
+
+  protected:
+	void threadedFunction();
+	void ProcessMessage(const osc::ReceivedMessage& m, const IpEndpointName& remoteEndpoint);
+	void ProcessBundle(const osc::ReceivedBundle& b, const IpEndpointName& remoteEndpoint);
+
+	UdpListeningReceiveSocket* socket;
+	DurationWakeup* wakeup;
+	vector<ofxOscMessage> ring;
+	size_t mask;
+
+	std::atomic<size_t> head; //next slot the receive thread fills
+	std::atomic<size_t> tail; //next slot the consumer reads
+	std::atomic<unsigned long> dropped;
+
+	ofMutex statsMutex;
+	int scheduledBundles;
+	int lateBundles;
+	double marginMin;
+	double marginMax;
+	double marginSum;
+	double marginSquaredSum;
+};
@@ -0,0 +1,295 @@
+/**
+ * Duration
+ * Standalone timeline for Creative Code
+ *
+ * Copyright (c) 2012 James George
+ * Development Supported by YCAM InterLab http://interlab.ycam.jp/en/
+ * http://jamesgeorge.org + http://flightphase.com
+ * http://github.com/obviousjim + http://github.com/flightphase
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include "DurationOscSender.h"
+
+#ifdef TARGET_WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+typedef int socklen_t;
+#define DURATION_INVALID_SOCKET INVALID_SOCKET
+#define DURATION_CLOSE_SOCKET closesocket
+#else
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netdb.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#define DURATION_INVALID_SOCKET -1
+#define DURATION_CLOSE_SOCKET ::close
+#endif
+
+//"#bundle" and the timetag
+#define DURATION_BUNDLE_HEADER_SIZE 16
+
+static int readInt32(const char* data){
+	const unsigned char* bytes = (const unsigned char*)data;
+	return (bytes[0] << 24) | (bytes[1] << 16) | (bytes[2] << 8) | bytes[3];
+}
+
+DurationOscSender::DurationOscSender(){
+	socketHandle = DURATION_INVALID_SOCKET;
+	multicastEnabled = false;
+	multicastTTL = 1;
+
+	maxPacketSize = 1400;
+	frameNumber = 0;
+	oversizeReported = false;
+	DurationOscWriter::buildPrefix("/duration/frame", ",iii", frameTagPrefix);
+
+	#ifdef TARGET_WIN32
+	WSADATA wsaData;
+	WSAStartup(MAKEWORD(2, 2), &wsaData);
+	#endif
+}
+
+DurationOscSender::~DurationOscSender(){
+	close();
+	#ifdef TARGET_WIN32
+	WSACleanup();
+	#endif
+}
+
+bool DurationOscSender::setup(string host, int port){
+	vector<DurationOscDestination> destinations(1);
+	destinations[0].host = host;
+	destinations[0].port = port;
+	destinations[0].enabled = true;
+	return setup(destinations);
+}
+
+bool DurationOscSender::setup(const vector<DurationOscDestination>& destinations){
+	close();
+
+	socketHandle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if(socketHandle == DURATION_INVALID_SOCKET){
+		ofLogError("DurationOscSender::setup") << "Could not create socket";
+		return false;
+	}
+
+	if(multicastEnabled){
+		//one datagram reaches every node in the group, looped back so nodes on this machine get it too
+		int ttl = multicastTTL;
+		int loop = 1;
+		if(setsockopt(socketHandle, IPPROTO_IP, IP_MULTICAST_TTL, (const char*)&ttl, sizeof(ttl)) != 0 ||
+		   setsockopt(socketHandle, IPPROTO_IP, IP_MULTICAST_LOOP, (const char*)&loop, sizeof(loop)) != 0){
+			ofLogError("DurationOscSender::setup") << "Could not set multicast TTL " << multicastTTL;
+		}
+		if(multicastInterface != ""){
+			in_addr interfaceAddress;
+			if(inet_pton(AF_INET, multicastInterface.c_str(), &interfaceAddress) != 1 ||
+			   setsockopt(socketHandle, IPPROTO_IP, IP_MULTICAST_IF, (const char*)&interfaceAddress, sizeof(interfaceAddress)) != 0){
+				ofLogError("DurationOscSender::setup") << "Could not send multicast on interface " << multicastInterface;
+			}
+		}
+	}
+
+	bool allResolved = true;
+	for(int i = 0; i < destinations.size(); i++){
+		const DurationOscDestination& destination = destinations[i];
+		addrinfo hints;
+		memset(&hints, 0, sizeof(hints));
+		hints.ai_family = AF_INET;
+		hints.ai_socktype = SOCK_DGRAM;
+		addrinfo* result = NULL;
+		if(getaddrinfo(destination.host.c_str(), ofToString(destination.port).c_str(), &hints, &result) != 0 || result == NULL){
+			ofLogError("DurationOscSender::setup") << "Could not resolve " << destination.host << ":" << destination.port;
+			allResolved = false;
+			continue;
+		}
+
+		DurationOscEndpoint endpoint;
+		endpoint.settings = destination;
+		endpoint.addressSize = MIN(result->ai_addrlen, sizeof(endpoint.address));
+		memcpy(endpoint.address, result->ai_addr, endpoint.addressSize);
+		endpoint.sendFailed = false;
+		freeaddrinfo(result);
+
+		vector<string> prefixes = ofSplitString(destination.addressFilter, ",", true, true);
+		for(int p = 0; p < prefixes.size(); p++){
+			endpoint.prefixes.push_back(ofFilePath::addLeadingSlash(prefixes[p]));
+		}
+		endpoints.push_back(endpoint);
+	}
+	return allResolved;
+}
+
+void DurationOscSender::close(){
+	if(socketHandle != DURATION_INVALID_SOCKET){
+		DURATION_CLOSE_SOCKET(socketHandle);
+		socketHandle = DURATION_INVALID_SOCKET;
+	}
+	endpoints.clear();
+}
+
+void DurationOscSender::setMulticast(bool enabled, int ttl, string interfaceAddress){
+	multicastEnabled = enabled;
+	multicastTTL = ofClamp(ttl, 0, 255);
+	multicastInterface = interfaceAddress;
+}
+
+void DurationOscSender::setMaxPacketSize(int bytes){
+	//room for the bundle header, the frame tag and at least one small message
+	maxPacketSize = MAX(bytes, 128);
+}
+
+int DurationOscSender::getMaxPacketSize(){
+	return maxPacketSize;
+}
+
+bool DurationOscSender::matchesFilter(DurationOscEndpoint& endpoint, const char* address){
+	if(endpoint.prefixes.empty()){
+		return true;
+	}
+	for(int i = 0; i < endpoint.prefixes.size(); i++){
+		if(strncmp(address, endpoint.prefixes[i].c_str(), endpoint.prefixes[i].size()) == 0){
+			return true;
+		}
+	}
+	return false;
+}
+
+bool DurationOscSender::sendFrame(DurationOscWriter& frame){
+	const char* data = frame.getData();
+	int size = frame.getSize();
+	frameNumber++;
+
+	bool sent = true;
+	for(int i = 0; i < endpoints.size(); i++){
+		DurationOscEndpoint& endpoint = endpoints[i];
+		if(!endpoint.settings.enabled){
+			continue;
+		}
+		if(endpoint.prefixes.empty() || size <= DURATION_BUNDLE_HEADER_SIZE){
+			sent &= sendParts(endpoint, data, size);
+			continue;
+		}
+
+		//copy the matching elements, they are already encoded
+		filterWriter.clear();
+		filterWriter.append(data, DURATION_BUNDLE_HEADER_SIZE);
+		for(int offset = DURATION_BUNDLE_HEADER_SIZE; offset < size; ){
+			int elementSize = 4 + readInt32(data + offset);
+			if(matchesFilter(endpoint, data + offset + 4)){
+				filterWriter.append(data + offset, elementSize);
+			}
+			offset += elementSize;
+		}
+		if(filterWriter.getSize() > DURATION_BUNDLE_HEADER_SIZE){
+			sent &= sendParts(endpoint, filterWriter.getData(), filterWriter.getSize());
+		}
+	}
+	return sent;
+}
+
+bool DurationOscSender::sendParts(DurationOscEndpoint& endpoint, const char* data, int size){
+	if(size <= maxPacketSize || size <= DURATION_BUNDLE_HEADER_SIZE){
+		return sendTo(endpoint, data, size);
+	}
+
+	//find where each part ends, only splitting between bundle elements
+	int room = maxPacketSize - DURATION_BUNDLE_HEADER_SIZE - (4 + frameTagPrefix.size() + 12);
+	partEnds.clear();
+	int partSize = 0;
+	for(int offset = DURATION_BUNDLE_HEADER_SIZE; offset < size; ){
+		int elementSize = 4 + readInt32(data + offset);
+		if(partSize > 0 && partSize + elementSize > room){
+			partEnds.push_back(offset);
+			partSize = 0;
+		}
+		if(elementSize > room && !oversizeReported){
+			ofLogWarning("DurationOscSender::sendFrame") << "A " << elementSize << " byte message does not fit in " << maxPacketSize << " byte packets and will be sent on its own";
+			oversizeReported = true;
+		}
+		partSize += elementSize;
+		offset += elementSize;
+	}
+	partEnds.push_back(size);
+
+	//every part keeps the original timetag
+	unsigned long long timetag = ((unsigned long long)(unsigned int)readInt32(data + 8) << 32) | (unsigned int)readInt32(data + 12);
+	int numParts = partEnds.size();
+	int partStart = DURATION_BUNDLE_HEADER_SIZE;
+	bool sent = true;
+	for(int part = 0; part < numParts; part++){
+		partWriter.clear();
+		partWriter.beginBundle(timetag);
+		partWriter.beginMessage(frameTagPrefix);
+		partWriter.addInt(frameNumber);
+		partWriter.addInt(part);
+		partWriter.addInt(numParts);
+		partWriter.endMessage();
+		partWriter.append(data + partStart, partEnds[part] - partStart);
+		sent &= sendTo(endpoint, partWriter.getData(), partWriter.getSize());
+		partStart = partEnds[part];
+	}
+	return sent;
+}
+
+bool DurationOscSender::sendTo(DurationOscEndpoint& endpoint, const char* data, int size){
+	if(socketHandle == DURATION_INVALID_SOCKET){
+		return false;
+	}
+	if(sendto(socketHandle, data, size, 0, (sockaddr*)endpoint.address, (socklen_t)endpoint.addressSize) != size){
+		//only report the first failure of a run, a missing route would flood the log
+		if(!endpoint.sendFailed){
+			ofLogError("DurationOscSender::send") << "Failed to send " << size << " bytes to " << endpoint.settings.host << ":" << endpoint.settings.port;
+			endpoint.sendFailed = true;
+		}
+		return false;
+	}
+	endpoint.sendFailed = false;
+	return true;
+}
+
+bool DurationOscSender::sendMessage(ofxOscMessage& message){
+	bundleWriter.clear();
+	bundleWriter.addMessage(message);
+	bool sent = true;
+	for(int i = 0; i < endpoints.size(); i++){
+		if(endpoints[i].settings.enabled && matchesFilter(endpoints[i], bundleWriter.getData())){
+			sent &= sendTo(endpoints[i], bundleWriter.getData(), bundleWriter.getSize());
+		}
+	}
+	return sent;
+}
+
+bool DurationOscSender::sendBundle(ofxOscBundle& bundle){
+	bundleWriter.clear();
+	bundleWriter.beginBundle();
+	for(int i = 0; i < bundle.getMessageCount(); i++){
+		bundleWriter.addMessage(bundle.getMessageAt(i));
+	}
+	return sendFrame(bundleWriter);
+}
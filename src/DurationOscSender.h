@@ -0,0 +1,101 @@
+/**
+ * Duration
+ * Standalone timeline for Creative Code
+ *
+ * Copyright (c) 2012 James George
+ * Development Supported by YCAM InterLab http://interlab.ycam.jp/en/
+ * http://jamesgeorge.org + http://flightphase.com
+ * http://github.com/obviousjim + http://github.com/flightphase
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#pragma once
+
+#include "ofMain.h"
+#include "ofxOsc.h"
+#include "DurationOscWriter.h"
+
+typedef struct {
+	string host;
+	int port;
+	bool enabled;
+	string addressFilter; //comma separated address prefixes, empty sends everything
+} DurationOscDestination;
+
+//resolved destination, the sockaddr is kept opaque so the platform socket headers stay in the .cpp
+typedef struct {
+	DurationOscDestination settings;
+	vector<string> prefixes;
+	unsigned char address[128];
+	int addressSize;
+	bool sendFailed;
+} DurationOscEndpoint;
+
+//UDP sender for buffers encoded by DurationOscWriter. Replaces ofxOscSender
+//so outgoing frames are not copied into ofxOscMessage objects first. Every
+//frame is encoded once and sent to each enabled destination, filtered
+//destinations get a copy of just the messages that match their prefixes.
+class DurationOscSender {
+  public:
+	DurationOscSender();
+	~DurationOscSender();
+
+	bool setup(string host, int port);
+	bool setup(const vector<DurationOscDestination>& destinations);
+	void close();
+
+	//socket options for multicast group destinations, applied on the next setup.
+	//an empty interface address leaves the choice to the OS
+	void setMulticast(bool enabled, int ttl, string interfaceAddress);
+
+	//sends an encoded bundle, split into several bundles when it is larger than the
+	//max packet size. each part then starts with /duration/frame frame:int part:int parts:int
+	bool sendFrame(DurationOscWriter& frame);
+	void setMaxPacketSize(int bytes);
+	int getMaxPacketSize();
+	//for the occasional ofxOsc message or bundle, encoded with an internal writer
+	bool sendMessage(ofxOscMessage& message);
+	bool sendBundle(ofxOscBundle& bundle);
+
+  protected:
+	bool matchesFilter(DurationOscEndpoint& endpoint, const char* address);
+	bool sendParts(DurationOscEndpoint& endpoint, const char* data, int size);
+	bool sendTo(DurationOscEndpoint& endpoint, const char* data, int size);
+
+	long long socketHandle;
+	bool multicastEnabled;
+	int multicastTTL;
+	string multicastInterface;
+	vector<DurationOscEndpoint> endpoints;
+	DurationOscWriter bundleWriter;
+	DurationOscWriter filterWriter;
+
+	int maxPacketSize;
+	int frameNumber;
+	bool oversizeReported;
+	vector<char> frameTagPrefix;
+	vector<int> partEnds;
+	DurationOscWriter partWriter;
+};
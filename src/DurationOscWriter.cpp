@@ -0,0 +1,227 @@
+/**
+ * Duration
+ * Standalone timeline for Creative Code
+ *
+ * Copyright (c) 2012 James George
+ * Development Supported by YCAM InterLab http://interlab.ycam.jp/en/
+ * http://jamesgeorge.org + http://flightphase.com
+ * http://github.com/obviousjim + http://github.com/flightphase
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include "DurationOscWriter.h"
+#include <chrono>
+
+//seconds between the NTP epoch (1900) and the unix epoch
+#define DURATION_NTP_UNIX_OFFSET 2208988800ULL
+
+DurationOscWriter::DurationOscWriter(){
+	size = 0;
+	messageStart = -1;
+	inBundle = false;
+	numGrowths = 0;
+	buffer.resize(4096);
+}
+
+void DurationOscWriter::reserve(int bytes){
+	if(bytes > buffer.size()){
+		buffer.resize(bytes);
+	}
+}
+
+void DurationOscWriter::clear(){
+	size = 0;
+	messageStart = -1;
+	inBundle = false;
+}
+
+void DurationOscWriter::ensure(int bytes){
+	if(size + bytes > buffer.size()){
+		buffer.resize(MAX(buffer.size() * 2, size + bytes));
+		numGrowths++;
+	}
+}
+
+void DurationOscWriter::writeInt32(int value){
+	ensure(4);
+	unsigned int v = value;
+	buffer[size++] = (v >> 24) & 0xFF;
+	buffer[size++] = (v >> 16) & 0xFF;
+	buffer[size++] = (v >> 8) & 0xFF;
+	buffer[size++] = v & 0xFF;
+}
+
+//OSC strings are null terminated and padded to four bytes
+void DurationOscWriter::writePadded(const char* data, int length){
+	int padded = (length / 4 + 1) * 4;
+	ensure(padded);
+	memcpy(&buffer[size], data, length);
+	memset(&buffer[size + length], 0, padded - length);
+	size += padded;
+}
+
+void DurationOscWriter::beginBundle(unsigned long long timetag){
+	inBundle = true;
+	writePadded("#bundle", 7);
+	writeInt32(timetag >> 32);
+	writeInt32(timetag & 0xFFFFFFFF);
+}
+
+void DurationOscWriter::beginMessage(const vector<char>& prefix){
+	//element size is filled in by endMessage
+	if(inBundle){
+		writeInt32(0);
+	}
+	messageStart = size;
+	ensure(prefix.size());
+	memcpy(&buffer[size], &prefix[0], prefix.size());
+	size += prefix.size();
+}
+
+void DurationOscWriter::addInt(int value){
+	writeInt32(value);
+}
+
+void DurationOscWriter::addFloat(float value){
+	int bits;
+	memcpy(&bits, &value, 4);
+	writeInt32(bits);
+}
+
+void DurationOscWriter::addString(const string& value){
+	writePadded(value.c_str(), value.size());
+}
+
+void DurationOscWriter::endMessage(){
+	if(messageStart < 0 || !inBundle){
+		messageStart = -1;
+		return;
+	}
+	unsigned int length = size - messageStart;
+	buffer[messageStart - 4] = (length >> 24) & 0xFF;
+	buffer[messageStart - 3] = (length >> 16) & 0xFF;
+	buffer[messageStart - 2] = (length >> 8) & 0xFF;
+	buffer[messageStart - 1] = length & 0xFF;
+	messageStart = -1;
+}
+
+void DurationOscWriter::append(const char* data, int length){
+	ensure(length);
+	memcpy(&buffer[size], data, length);
+	size += length;
+}
+
+void DurationOscWriter::addMessage(ofxOscMessage& message){
+	if(inBundle){
+		writeInt32(0);
+	}
+	messageStart = size;
+	string address = message.getAddress();
+	writePadded(address.c_str(), address.size());
+
+	//type tags are written in place, then padded
+	int numArgs = message.getNumArgs();
+	ensure(numArgs + 1);
+	int tagStart = size;
+	buffer[size++] = ',';
+	for(int i = 0; i < numArgs; i++){
+		switch(message.getArgType(i)){
+			case OFXOSC_TYPE_INT32:  buffer[size++] = 'i'; break;
+			case OFXOSC_TYPE_INT64:  buffer[size++] = 'h'; break;
+			case OFXOSC_TYPE_FLOAT:  buffer[size++] = 'f'; break;
+			case OFXOSC_TYPE_STRING: buffer[size++] = 's'; break;
+			default:
+				ofLogError("DurationOscWriter") << "Unsupported argument type in " << address;
+				buffer[size++] = 'N';
+				break;
+		}
+	}
+	int tagLength = size - tagStart;
+	size = tagStart;
+	int padded = (tagLength / 4 + 1) * 4;
+	ensure(padded);
+	memset(&buffer[size + tagLength], 0, padded - tagLength);
+	size += padded;
+
+	for(int i = 0; i < numArgs; i++){
+		switch(message.getArgType(i)){
+			case OFXOSC_TYPE_INT32:
+				writeInt32(message.getArgAsInt32(i));
+				break;
+			case OFXOSC_TYPE_INT64:{
+				long long value = message.getArgAsInt64(i);
+				writeInt32(value >> 32);
+				writeInt32(value & 0xFFFFFFFF);
+				break;
+			}
+			case OFXOSC_TYPE_FLOAT:
+				addFloat(message.getArgAsFloat(i));
+				break;
+			case OFXOSC_TYPE_STRING:
+				addString(message.getArgAsString(i));
+				break;
+			default:
+				break;
+		}
+	}
+	endMessage();
+}
+
+const char* DurationOscWriter::getData(){
+	return &buffer[0];
+}
+
+int DurationOscWriter::getSize(){
+	return size;
+}
+
+int DurationOscWriter::getNumGrowths(){
+	return numGrowths;
+}
+
+static unsigned long long getUnixMicros(){
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+unsigned long long DurationOscWriter::getTimetag(unsigned long long microsFromNow){
+	unsigned long long micros = getUnixMicros() + microsFromNow;
+	unsigned long long seconds = micros / 1000000 + DURATION_NTP_UNIX_OFFSET;
+	unsigned long long fraction = ((micros % 1000000) << 32) / 1000000;
+	return (seconds << 32) | fraction;
+}
+
+long long DurationOscWriter::getMicrosUntil(unsigned long long timetag){
+	unsigned long long seconds = (timetag >> 32) - DURATION_NTP_UNIX_OFFSET;
+	unsigned long long micros = seconds * 1000000 + (((timetag & 0xFFFFFFFFULL) * 1000000) >> 32);
+	return (long long)micros - (long long)getUnixMicros();
+}
+
+void DurationOscWriter::buildPrefix(const string& address, const string& typeTags, vector<char>& prefix){
+	int addressLength = (address.size() / 4 + 1) * 4;
+	int tagLength = (typeTags.size() / 4 + 1) * 4;
+	prefix.assign(addressLength + tagLength, 0);
+	memcpy(&prefix[0], address.c_str(), address.size());
+	memcpy(&prefix[addressLength], typeTags.c_str(), typeTags.size());
+}
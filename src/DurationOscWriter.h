@@ -0,0 +1,84 @@
+/**
+ * Duration
+ * Standalone timeline for Creative Code
+ *
+ * Copyright (c) 2012 James George
+ * Development Supported by YCAM InterLab http://interlab.ycam.jp/en/
+ * http://jamesgeorge.org + http://flightphase.com
+ * http://github.com/obviousjim + http://github.com/flightphase
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#pragma once
+
+#include "ofMain.h"
+#include "ofxOsc.h"
+
+//Encodes OSC bundles straight into a reusable byte buffer. Messages with a
+//fixed layout are started from a prebuilt address and type tag prefix, so
+//once the buffer has grown to the largest frame nothing is allocated.
+class DurationOscWriter {
+  public:
+	DurationOscWriter();
+
+	void reserve(int bytes);
+	void clear();
+
+	void beginBundle(unsigned long long timetag = 1); //1 means immediately
+	void beginMessage(const vector<char>& prefix);
+	void addInt(int value);
+	void addFloat(float value);
+	void addString(const string& value);
+	void endMessage();
+	//copies already encoded bundle elements
+	void append(const char* data, int length);
+
+	//slow path for messages without a prefix, like bangs and remote panel writes.
+	//called without beginBundle it writes a bare message
+	void addMessage(ofxOscMessage& message);
+
+	const char* getData();
+	int getSize();
+	int getNumGrowths();
+
+	//NTP time tag for the given number of microseconds from now
+	static unsigned long long getTimetag(unsigned long long microsFromNow);
+	//microseconds from now until an NTP time tag, negative when it has passed
+	static long long getMicrosUntil(unsigned long long timetag);
+
+	//padded address followed by the padded type tags, eg ",fff"
+	static void buildPrefix(const string& address, const string& typeTags, vector<char>& prefix);
+
+  protected:
+	void ensure(int bytes);
+	void writeInt32(int value);
+	void writePadded(const char* data, int length);
+
+	vector<char> buffer;
+	int size;
+	int messageStart;
+	bool inBundle;
+	int numGrowths;
+};
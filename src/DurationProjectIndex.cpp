@@ -0,0 +1,205 @@
+/**
+ * Duration
+ * Standalone timeline for Creative Code
+ *
+ * Copyright (c) 2012 James George
+ * Development Supported by YCAM InterLab http://interlab.ycam.jp/en/
+ * http://jamesgeorge.org + http://flightphase.com
+ * http://github.com/obviousjim + http://github.com/flightphase
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include "DurationProjectIndex.h"
+#include <sys/stat.h>
+
+DurationProjectIndex::DurationProjectIndex(){
+	directoryModified = 0;
+	updated = false;
+}
+
+DurationProjectIndex::~DurationProjectIndex(){
+	close();
+}
+
+void DurationProjectIndex::setup(string path, string projectDirectory){
+	close();
+	indexPath = path;
+	directory = projectDirectory;
+	updated = false;
+	if(!load()){
+		directoryModified = 0;
+		folders.clear();
+	}
+	startThread();
+}
+
+void DurationProjectIndex::close(){
+	if(isThreadRunning()){
+		waitForThread(true);
+	}
+}
+
+vector<string> DurationProjectIndex::getProjects(){
+	vector<string> projects;
+	lock();
+	for(int i = 0; i < folders.size(); i++){
+		if(folders[i].isProject){
+			projects.push_back(folders[i].name);
+		}
+	}
+	unlock();
+	return projects;
+}
+
+bool DurationProjectIndex::hasUpdate(){
+	lock();
+	bool wasUpdated = updated;
+	updated = false;
+	unlock();
+	return wasUpdated;
+}
+
+void DurationProjectIndex::threadedFunction(){
+	unsigned long long start = ofGetElapsedTimeMillis();
+	lock();
+	vector<DurationIndexedFolder> indexed = folders;
+	time_t indexedModified = directoryModified;
+	unlock();
+
+	//folders are only added, removed or renamed if the directory itself changed
+	time_t modified = getModified(directory);
+	vector<string> names;
+	if(modified != indexedModified || modified == 0){
+		ofDirectory projectDirectory(directory);
+		projectDirectory.listDir();
+		for(int i = 0; i < projectDirectory.size(); i++){
+			if(projectDirectory.getFile(i).isDirectory()){
+				names.push_back(projectDirectory.getName(i));
+			}
+		}
+	}
+	else{
+		for(int i = 0; i < indexed.size(); i++){
+			names.push_back(indexed[i].name);
+		}
+	}
+
+	//a folder that kept its modified time still has or lacks its .durationproj
+	vector<DurationIndexedFolder> scanned;
+	int numListed = 0;
+	for(int i = 0; i < names.size() && isThreadRunning(); i++){
+		DurationIndexedFolder folder;
+		folder.name = names[i];
+		folder.modified = getModified(ofFilePath::join(directory, names[i]));
+		folder.isProject = false;
+		bool known = false;
+		for(int f = 0; f < indexed.size() && !known; f++){
+			if(indexed[f].name == folder.name && indexed[f].modified == folder.modified){
+				folder.isProject = indexed[f].isProject;
+				known = true;
+			}
+		}
+		if(!known){
+			ofDirectory subDir(ofFilePath::join(directory, names[i]));
+			subDir.allowExt("durationproj");
+			subDir.setShowHidden(true);
+			subDir.listDir();
+			folder.isProject = subDir.size() > 0;
+			numListed++;
+		}
+		scanned.push_back(folder);
+	}
+	if(!isThreadRunning()){
+		return;
+	}
+
+	lock();
+	bool changed = modified != directoryModified || scanned.size() != folders.size();
+	bool projectsChanged = scanned.size() != folders.size();
+	for(int i = 0; i < scanned.size() && !projectsChanged; i++){
+		changed |= scanned[i].modified != folders[i].modified;
+		projectsChanged = scanned[i].name != folders[i].name || scanned[i].isProject != folders[i].isProject;
+	}
+	folders = scanned;
+	directoryModified = modified;
+	updated = projectsChanged;
+	unlock();
+
+	if(changed || projectsChanged){
+		save();
+	}
+	ofLogVerbose("DurationProjectIndex") << "Checked " << scanned.size() << " project folders, listed " << numListed << " of them in " << ofGetElapsedTimeMillis() - start << " ms";
+}
+
+bool DurationProjectIndex::load(){
+	ofxXmlSettings index;
+	if(!index.loadFile(indexPath) || index.getValue("projectIndex:directory", "") != directory){
+		return false;
+	}
+	index.pushTag("projectIndex");
+	directoryModified = strtoll(index.getValue("modified", "0").c_str(), NULL, 10);
+	folders.clear();
+	int numFolders = index.getNumTags("folder");
+	for(int i = 0; i < numFolders; i++){
+		index.pushTag("folder", i);
+		DurationIndexedFolder folder;
+		folder.name = index.getValue("name", "");
+		folder.modified = strtoll(index.getValue("modified", "0").c_str(), NULL, 10);
+		folder.isProject = index.getValue("isProject", false);
+		folders.push_back(folder);
+		index.popTag(); //folder
+	}
+	index.popTag(); //projectIndex
+	return true;
+}
+
+void DurationProjectIndex::save(){
+	ofxXmlSettings index;
+	index.addTag("projectIndex");
+	index.pushTag("projectIndex");
+	lock();
+	index.addValue("directory", directory);
+	//times are kept as text so they aren't cut down to an int
+	index.addValue("modified", ofToString((long long)directoryModified));
+	for(int i = 0; i < folders.size(); i++){
+		index.addTag("folder");
+		index.pushTag("folder", i);
+		index.addValue("name", folders[i].name);
+		index.addValue("modified", ofToString((long long)folders[i].modified));
+		index.addValue("isProject", folders[i].isProject);
+		index.popTag(); //folder
+	}
+	unlock();
+	index.popTag(); //projectIndex
+	index.saveFile(indexPath);
+}
+
+time_t DurationProjectIndex::getModified(string path){
+	struct stat info;
+	if(stat(ofFilePath::removeTrailingSlash(path).c_str(), &info) != 0){
+		return 0;
+	}
+	return info.st_mtime;
+}
@@ -0,0 +1,74 @@
+/**
+ * Duration
+ * Standalone timeline for Creative Code
+ *
+ * Copyright (c) 2012 James George
+ * Development Supported by YCAM InterLab http://interlab.ycam.jp/en/
+ * http://jamesgeorge.org + http://flightphase.com
+ * http://github.com/obviousjim + http://github.com/flightphase
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#pragma once
+
+#include "ofMain.h"
+#include "ofxXmlSettings.h"
+
+typedef struct {
+	string name;
+	time_t modified; //of the folder itself, changes when files are added or removed in it
+	bool isProject; //holds a .durationproj
+} DurationIndexedFolder;
+
+//The folders of the project directory and which of them are projects, kept
+//in an XML file so the project list is there at startup without listing every
+//folder. The index is checked against the folders' modified times on its own
+//thread, only folders that changed since the last scan are listed again.
+class DurationProjectIndex : public ofThread {
+  public:
+	DurationProjectIndex();
+	~DurationProjectIndex();
+
+	//reads the index for directory from indexPath and starts a scan
+	void setup(string indexPath, string directory);
+	void close();
+
+	//project names as of the index, or the last scan once it has finished
+	vector<string> getProjects();
+	//true once after a scan found the projects differ from what getProjects returned
+	bool hasUpdate();
+
+  protected:
+	void threadedFunction();
+	bool load();
+	void save();
+	static time_t getModified(string path);
+
+	string indexPath;
+	string directory;
+	time_t directoryModified;
+	vector<DurationIndexedFolder> folders;
+	bool updated;
+};
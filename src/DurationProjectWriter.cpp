@@ -0,0 +1,162 @@
+/**
+ * Duration
+ * Standalone timeline for Creative Code
+ *
+ * Copyright (c) 2012 James George
+ * Development Supported by YCAM InterLab http://interlab.ycam.jp/en/
+ * http://jamesgeorge.org + http://flightphase.com
+ * http://github.com/obviousjim + http://github.com/flightphase
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include "DurationProjectWriter.h"
+
+DurationProjectWriter::DurationProjectWriter(){
+	hasPending = false;
+	pendingGeneration = 0;
+	lastGeneration = 0;
+	writing = false;
+	numSaves = 0;
+	lastSaveFailed = false;
+}
+
+DurationProjectWriter::~DurationProjectWriter(){
+	close();
+}
+
+int DurationProjectWriter::save(vector<DurationSaveFile>& files){
+	lock();
+	pending.swap(files);
+	hasPending = true;
+	int generation = ++pendingGeneration;
+	unlock();
+
+	if(!isThreadRunning()){
+		startThread();
+	}
+	wakeup.notify();
+	return generation;
+}
+
+void DurationProjectWriter::waitForSaves(){
+	while(isSaving()){
+		ofSleepMillis(1);
+	}
+}
+
+void DurationProjectWriter::close(){
+	if(isThreadRunning()){
+		waitForSaves();
+		stopThread();
+		wakeup.notify();
+		waitForThread(false);
+	}
+}
+
+bool DurationProjectWriter::isSaving(){
+	lock();
+	bool saving = hasPending || writing;
+	unlock();
+	return saving;
+}
+
+int DurationProjectWriter::getNumSaves(){
+	lock();
+	int saves = numSaves;
+	unlock();
+	return saves;
+}
+
+bool DurationProjectWriter::getLastSaveFailed(){
+	lock();
+	bool failed = lastSaveFailed;
+	unlock();
+	return failed;
+}
+
+int DurationProjectWriter::getLastSaveGeneration(){
+	lock();
+	int generation = lastGeneration;
+	unlock();
+	return generation;
+}
+
+void DurationProjectWriter::threadedFunction(){
+	while(isThreadRunning()){
+		lock();
+		if(!hasPending){
+			unlock();
+			wakeup.wait();
+			continue;
+		}
+		vector<DurationSaveFile> files;
+		files.swap(pending);
+		int generation = pendingGeneration;
+		hasPending = false;
+		writing = true;
+		unlock();
+
+		unsigned long long start = ofGetElapsedTimeMillis();
+		bool failed = false;
+		size_t numBytes = 0;
+		for(int i = 0; i < files.size(); i++){
+			failed |= !writeFile(files[i]);
+			numBytes += files[i].contents.size();
+		}
+		ofLogVerbose("DurationProjectWriter") << "Wrote " << files.size() << " files, " << numBytes << " bytes in " << ofGetElapsedTimeMillis() - start << " ms";
+
+		lock();
+		writing = false;
+		numSaves++;
+		lastSaveFailed = failed;
+		lastGeneration = generation;
+		unlock();
+	}
+}
+
+bool DurationProjectWriter::writeFile(const DurationSaveFile& file){
+	string path = ofToDataPath(file.path);
+	string temporaryPath = path + ".saving";
+	ofstream out(temporaryPath.c_str(), ios::out | ios::binary | ios::trunc);
+	out.write(file.contents.data(), file.contents.size());
+	out.close();
+	if(out.fail()){
+		ofLogError("DurationProjectWriter::writeFile") << "Could not write " << temporaryPath;
+		remove(temporaryPath.c_str());
+		return false;
+	}
+
+#ifdef TARGET_WIN32
+	bool renamed = MoveFileExA(temporaryPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+#else
+	bool renamed = rename(temporaryPath.c_str(), path.c_str()) == 0;
+#endif
+	if(!renamed){
+		ofLogError("DurationProjectWriter::writeFile") << "Could not replace " << path;
+		remove(temporaryPath.c_str());
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,79 @@
+/**
+ * Duration
+ * Standalone timeline for Creative Code
+ *
+ * Copyright (c) 2012 James George
+ * Development Supported by YCAM InterLab http://interlab.ycam.jp/en/
+ * http://jamesgeorge.org + http://flightphase.com
+ * http://github.com/obviousjim + http://github.com/flightphase
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#pragma once
+
+#include "ofMain.h"
+#include "DurationWakeup.h"
+
+typedef struct {
+	string path;
+	string contents;
+} DurationSaveFile;
+
+//Writes a project's files on its own thread, so a save copies the project
+//into memory and returns, without holding up drawing or OSC output. Each file
+//is written next to its destination and renamed over it, so a save cut short
+//leaves the previous version in place.
+class DurationProjectWriter : public ofThread {
+  public:
+	DurationProjectWriter();
+	~DurationProjectWriter();
+
+	//takes the files, a save still waiting to start is replaced by the newer one.
+	//returns the save's generation, which counts up from 1
+	int save(vector<DurationSaveFile>& files);
+	//blocks until everything queued is on disk
+	void waitForSaves();
+	void close();
+
+	bool isSaving();
+	//saves finished so far, and whether the last one failed
+	int getNumSaves();
+	bool getLastSaveFailed();
+	//generation of the last save written. a replaced save is covered by the one replacing it
+	int getLastSaveGeneration();
+
+  protected:
+	void threadedFunction();
+	bool writeFile(const DurationSaveFile& file);
+
+	DurationWakeup wakeup;
+	vector<DurationSaveFile> pending;
+	bool hasPending;
+	int pendingGeneration;
+	int lastGeneration;
+	bool writing;
+	int numSaves;
+	bool lastSaveFailed;
+};
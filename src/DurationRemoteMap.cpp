@@ -0,0 +1,281 @@
+/**
+ * Duration
+ * Standalone timeline for Creative Code
+ *
+ * Copyright (c) 2012 James George
+ * Development Supported by YCAM InterLab http://interlab.ycam.jp/en/
+ * http://jamesgeorge.org + http://flightphase.com
+ * http://github.com/obviousjim + http://github.com/flightphase
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include "DurationRemoteMap.h"
+
+static const DurationRemoteParameter remoteParameters[] = {
+	//video
+	{"active quad",      "/active/set",                           DURATION_REMOTE_FLOAT, -1},
+	{"v on/off",         "/active/video/show",                    DURATION_REMOTE_INT,   -1},
+	{"v load",           "/active/video/load",                    DURATION_REMOTE_INT,   -1},
+	{"v x scale",        "/active/video/mult/x",                  DURATION_REMOTE_FLOAT, -1},
+	{"v y scale",        "/active/video/mult/y",                  DURATION_REMOTE_FLOAT, -1},
+	{"v fit",            "/active/video/fit",                     DURATION_REMOTE_INT,   -1},
+	{"v keep aspect",    "/active/video/keepaspect",              DURATION_REMOTE_INT,   -1},
+	{"v hflip",          "/active/video/hmirror",                 DURATION_REMOTE_INT,   -1},
+	{"v vflip",          "/active/video/vmirror",                 DURATION_REMOTE_INT,   -1},
+	{"v red",            "/active/video/color/1",                 DURATION_REMOTE_FLOAT, -1},
+	{"v green",          "/active/video/color/2",                 DURATION_REMOTE_FLOAT, -1},
+	{"v blue",           "/active/video/color/3",                 DURATION_REMOTE_FLOAT, -1},
+	{"v alpha",          "/active/video/color/4",                 DURATION_REMOTE_FLOAT, -1},
+	{"audio",            "/active/video/volume",                  DURATION_REMOTE_FLOAT, -1},
+	{"speed",            "/active/video/speed",                   DURATION_REMOTE_FLOAT, -1},
+	{"v loop",           "/active/video/loop",                    DURATION_REMOTE_FLOAT, -1},
+	{"v greenscreen",    "/active/video/greenscreen",             DURATION_REMOTE_FLOAT, -1},
+
+	//greenscreen
+	{"threshold",        "/active/greenscreen/threshold",         DURATION_REMOTE_FLOAT, -1},
+	{"gs red",           "/active/greenscreen/color/1",           DURATION_REMOTE_FLOAT, -1},
+	{"gs green",         "/active/greenscreen/color/2",           DURATION_REMOTE_FLOAT, -1},
+	{"gs blue",          "/active/greenscreen/color/3",           DURATION_REMOTE_FLOAT, -1},
+	{"gs alpha",         "/active/greenscreen/color/4",           DURATION_REMOTE_FLOAT, -1},
+
+	//kinect
+	{"k on/off",         "/active/kinect/show",                   DURATION_REMOTE_FLOAT, -1},
+	{"k close/open",     "/active/kinect/close",                  DURATION_REMOTE_FLOAT, -1},
+	{"k show img",       "/active/kinect/show/image",             DURATION_REMOTE_FLOAT, -1},
+	{"k grayscale",      "/active/kinect/show/grayscale",         DURATION_REMOTE_FLOAT, -1},
+	{"k mask",           "/active/kinect/mask",                   DURATION_REMOTE_FLOAT, -1},
+	{"k detect",         "/active/kinect/contour",                DURATION_REMOTE_FLOAT, -1},
+	{"k scale x",        "/active/kinect/mult/x",                 DURATION_REMOTE_FLOAT, -1},
+	{"k scale y",        "/active/kinect/mult/y",                 DURATION_REMOTE_FLOAT, -1},
+	{"k threshold near", "/active/kinect/threshold/near",         DURATION_REMOTE_FLOAT, -1},
+	{"k threshold far",  "/active/kinect/threshold/far",          DURATION_REMOTE_FLOAT, -1},
+	{"k angle",          "/active/kinect/angle",                  DURATION_REMOTE_FLOAT, -1},
+	{"k blur",           "/active/kinect/blur",                   DURATION_REMOTE_FLOAT, -1},
+	{"k smooth",         "/active/kinect/contour/smooth",         DURATION_REMOTE_FLOAT, -1},
+	{"k simplify",       "/active/kinect/contour/simplify",       DURATION_REMOTE_FLOAT, -1},
+	{"k min blob",       "/active/kinect/contour/area/min",       DURATION_REMOTE_FLOAT, -1},
+	{"k max blob",       "/active/kinect/contour/area/max",       DURATION_REMOTE_FLOAT, -1},
+	{"k red",            "/active/kinect/color/1",                DURATION_REMOTE_FLOAT, -1},
+	{"k green",          "/active/kinect/color/2",                DURATION_REMOTE_FLOAT, -1},
+	{"k blue",           "/active/kinect/color/3",                DURATION_REMOTE_FLOAT, -1},
+	{"k alpha",          "/active/kinect/color/4",                DURATION_REMOTE_FLOAT, -1},
+
+	//slideshow
+	{"sh on/off",        "/active/slideshow/show",                DURATION_REMOTE_FLOAT, -1},
+	{"sh load",          "/active/slideshow/folder",              DURATION_REMOTE_FLOAT, -1},
+	{"sh fit",           "/active/slideshow/fit",                 DURATION_REMOTE_FLOAT, -1},
+	{"sh aspect ratio",  "/active/slideshow/keep_aspect",         DURATION_REMOTE_FLOAT, -1},
+	{"sh greenscreen",   "/active/slideshow/greenscreen",         DURATION_REMOTE_FLOAT, -1},
+	{"sh duration",      "/active/slideshow/duration",            DURATION_REMOTE_FLOAT, -1},
+	//{"show/hide",        "/active/show",                          DURATION_REMOTE_FLOAT, -1},
+
+	//timeline
+	{"use timeline",     "/projection/timeline/toggle",           DURATION_REMOTE_FLOAT, -1},
+	{"seconds",          "/projection/timeline/duration",         DURATION_REMOTE_FLOAT, -1},
+	{"tl tint",          "/active/timeline/tint",                 DURATION_REMOTE_FLOAT, -1},
+	{"tl color",         "/active/timeline/color",                DURATION_REMOTE_INT,   -1},
+	{"tl alpha",         "/active/timeline/alpha",                DURATION_REMOTE_INT,   -1},
+	{"tl 4 slides",      "/active/timeline/slides",               DURATION_REMOTE_INT,   -1},
+
+	//camera
+	{"c on/off",         "/active/cam/show",                      DURATION_REMOTE_INT,   -1},
+	{"c load",           "/active/cam/show",                      DURATION_REMOTE_INT,   -1},
+	{"c scale x",        "/active/cam/mult/x",                    DURATION_REMOTE_FLOAT, -1},
+	{"c scale y",        "/active/cam/mult/y",                    DURATION_REMOTE_FLOAT, -1},
+	{"c fit",            "/active/cam/fit",                       DURATION_REMOTE_INT,   -1},
+	{"c aspect ratio",   "/active/cam/keepaspect",                DURATION_REMOTE_INT,   -1},
+	{"c hflip",          "/active/cam/hmirror",                   DURATION_REMOTE_INT,   -1},
+	{"c vflip",          "/active/cam/vmirror",                   DURATION_REMOTE_INT,   -1},
+	{"c red",            "/active/cam/color/1",                   DURATION_REMOTE_FLOAT, -1},
+	{"c green",          "/active/cam/color/2",                   DURATION_REMOTE_FLOAT, -1},
+	{"c blue",           "/active/cam/color/3",                   DURATION_REMOTE_FLOAT, -1},
+	{"c alpha",          "/active/cam/color/4",                   DURATION_REMOTE_FLOAT, -1},
+	{"cam audio",        "/active/cam/volume",                    DURATION_REMOTE_FLOAT, -1},
+	{"c greenscreen",    "/active/cam/greenscreen",               DURATION_REMOTE_FLOAT, -1},
+	{"camera 0",         "/active/cam/num",                       DURATION_REMOTE_INT,   0},
+	{"camera 1",         "/active/cam/num",                       DURATION_REMOTE_INT,   1},
+	{"camera 2",         "/active/cam/num",                       DURATION_REMOTE_INT,   2},
+	{"camera 3",         "/active/cam/num",                       DURATION_REMOTE_INT,   3},
+
+	//image
+	{"i on/off",         "/active/img/show",                      DURATION_REMOTE_INT,   -1},
+	{"i load",           "/active/img/load",                      DURATION_REMOTE_INT,   -1},
+	{"i fit",            "/active/img/fit",                       DURATION_REMOTE_INT,   -1},
+	{"i aspect ratio",   "/active/img/keepaspect",                DURATION_REMOTE_INT,   -1},
+	{"i scale x",        "/active/img/mult/x",                    DURATION_REMOTE_FLOAT, -1},
+	{"i scale y",        "/active/img/mult/y",                    DURATION_REMOTE_FLOAT, -1},
+	{"i hflip",          "/active/img/hmirror",                   DURATION_REMOTE_INT,   -1},
+	{"i vflip",          "/active/img/vmirror",                   DURATION_REMOTE_INT,   -1},
+	{"i greenscreen",    "/active/img/greenscreen",               DURATION_REMOTE_INT,   -1},
+	{"i red",            "/active/img/color/1",                   DURATION_REMOTE_FLOAT, -1},
+	{"i green",          "/active/img/color/2",                   DURATION_REMOTE_FLOAT, -1},
+	{"i blue",           "/active/img/color/3",                   DURATION_REMOTE_FLOAT, -1},
+	{"i alpha",          "/active/img/color/4",                   DURATION_REMOTE_FLOAT, -1},
+
+	//placement
+	{"move x",           "/active/placement/x",                   DURATION_REMOTE_INT,   -1},
+	{"move y",           "/active/placement/y",                   DURATION_REMOTE_INT,   -1},
+	{"width",            "/active/placement/w",                   DURATION_REMOTE_INT,   -1},
+	{"height",           "/active/placement/h",                   DURATION_REMOTE_INT,   -1},
+	{"reset",            "/active/placement/reset",               DURATION_REMOTE_INT,   -1},
+
+	//edge blend
+	{"eb on/off",        "/active/edgeblend/show",                DURATION_REMOTE_INT,   -1},
+	{"power",            "/active/edgeblend/power",               DURATION_REMOTE_FLOAT, -1},
+	{"gamma",            "/active/edgeblend/gamma",               DURATION_REMOTE_FLOAT, -1},
+	{"luminance",        "/active/edgeblend/luminance",           DURATION_REMOTE_FLOAT, -1},
+	{"left edge",        "/active/edgeblend/amount/left",         DURATION_REMOTE_FLOAT, -1},
+	{"right edge",       "/active/edgeblend/amount/right",        DURATION_REMOTE_FLOAT, -1},
+	{"top edge",         "/active/edgeblend/amount/top",          DURATION_REMOTE_FLOAT, -1},
+	{"bottom edge",      "/active/edgeblend/amount/bottom",       DURATION_REMOTE_FLOAT, -1},
+
+	//blend modes
+	{"bm on/off",        "/active/blendmodes/show",               DURATION_REMOTE_INT,   -1},
+	{"screen",           "/active/blendmodes/mode",               DURATION_REMOTE_INT,   0},
+	{"add",              "/active/blendmodes/mode",               DURATION_REMOTE_INT,   1},
+	{"subtract",         "/active/blendmodes/mode",               DURATION_REMOTE_INT,   2},
+	{"multiply",         "/active/blendmodes/mode",               DURATION_REMOTE_INT,   3},
+
+	//solid color
+	{"sc on/off",        "/active/solid/show",                    DURATION_REMOTE_INT,   -1},
+	{"sc red",           "/active/solid/color/1",                 DURATION_REMOTE_FLOAT, -1},
+	{"sc green",         "/active/solid/color/2",                 DURATION_REMOTE_FLOAT, -1},
+	{"sc blue",          "/active/solid/color/3",                 DURATION_REMOTE_FLOAT, -1},
+	{"sc alpha",         "/active/solid/color/4",                 DURATION_REMOTE_FLOAT, -1},
+
+	//projection
+	{"live resync",      "/projection/resync",                    DURATION_REMOTE_INT,   -1},
+	{"live stop/start",  "/projection/stop",                      DURATION_REMOTE_INT,   -1},
+	{"direct save",      "/projection/save",                      DURATION_REMOTE_INT,   -1},
+	{"direct load",      "/projection/load",                      DURATION_REMOTE_INT,   -1},
+	{"load file",        "/projection/loadfile",                  DURATION_REMOTE_INT,   -1},
+	{"save file",        "/projection/savefile",                  DURATION_REMOTE_INT,   -1},
+	{"live fc on/off",   "/projection/fullscreen/toggle",         DURATION_REMOTE_INT,   -1},
+	{"display gui",      "/projection/gui/toggle",                DURATION_REMOTE_INT,   -1},
+	//{"modesetup on/off", "/projection/mode/setup/toggle",         DURATION_REMOTE_INT,   -1},
+
+	//mask
+	{"m on/off",         "/active/mask/show",                     DURATION_REMOTE_INT,   -1},
+	{"m invert",         "/active/mask/invert",                   DURATION_REMOTE_INT,   -1},
+	{"mask edit on/off", "/projection/mode/masksetup/toggle",     DURATION_REMOTE_INT,   -1},
+
+	//deform
+	{"d on/off",         "/active/deform/show",                   DURATION_REMOTE_INT,   -1},
+	{"bezier",           "/active/deform/bezier",                 DURATION_REMOTE_INT,   -1},
+	{"spherize light",   "/active/deform/bezier/spherize/light",  DURATION_REMOTE_INT,   -1},
+	{"spherize strong",  "/active/deform/bezier/spherize/strong", DURATION_REMOTE_INT,   -1},
+	{"bezier reset",     "/active/deform/bezier/reset",           DURATION_REMOTE_INT,   -1},
+	{"grid",             "/active/deform/grid",                   DURATION_REMOTE_INT,   -1},
+	{"rows num",         "/active/deform/grid/rows",              DURATION_REMOTE_FLOAT, -1},
+	{"columns num",      "/active/deform/grid/columns",           DURATION_REMOTE_FLOAT, -1},
+	{"edit",             "/active/deform/edit",                   DURATION_REMOTE_INT,   -1},
+
+	//crop
+	{"top",              "/active/crop/rectangular/top",          DURATION_REMOTE_FLOAT, -1},
+	{"right",            "/active/crop/rectangular/right",        DURATION_REMOTE_FLOAT, -1},
+	{"left",             "/active/crop/rectangular/left",         DURATION_REMOTE_FLOAT, -1},
+	{"bottom",           "/active/crop/rectangular/bottom",       DURATION_REMOTE_FLOAT, -1},
+	{"x",                "/active/crop/circular/x",               DURATION_REMOTE_FLOAT, -1},
+	{"y",                "/active/crop/circular/y",               DURATION_REMOTE_FLOAT, -1},
+	{"radius",           "/active/crop/circular/radius",          DURATION_REMOTE_FLOAT, -1},
+
+	//active surface
+	{"Number",           "/active/set",                           DURATION_REMOTE_FLOAT, -1},
+
+	//transition
+	{"tr on/off",        "/active/solid/trans/show",              DURATION_REMOTE_INT,   -1},
+	{"tr red",           "/active/solid/trans/color/1",           DURATION_REMOTE_FLOAT, -1},
+	{"tr green",         "/active/solid/trans/color/2",           DURATION_REMOTE_FLOAT, -1},
+	{"tr blue",          "/active/solid/trans/color/3",           DURATION_REMOTE_FLOAT, -1},
+	{"tr alpha",         "/active/solid/trans/color/4",           DURATION_REMOTE_FLOAT, -1},
+	{"tr duration",      "/active/solid/trans/duration",          DURATION_REMOTE_FLOAT, -1},
+	{"3d load",          "/active/3d/load",                       DURATION_REMOTE_INT,   -1},
+	{"3d scale x",       "/active/3d/scale/x",                    DURATION_REMOTE_FLOAT, -1},
+	{"3d scale y",       "/active/3d/scale/y",                    DURATION_REMOTE_FLOAT, -1},
+	{"3d scale z",       "/active/3d/scale/z",                    DURATION_REMOTE_FLOAT, -1},
+	{"3d rotate x",      "/active/3d/rotate/x",                   DURATION_REMOTE_FLOAT, -1},
+	{"3d rotate y",      "/active/3d/rotate/y",                   DURATION_REMOTE_FLOAT, -1},
+	{"3d rotate z",      "/active/3d/rotate/z",                   DURATION_REMOTE_FLOAT, -1},
+	{"3d move x",        "/active/3d/move/x",                     DURATION_REMOTE_FLOAT, -1},
+	{"3d move y",        "/active/3d/move/y",                     DURATION_REMOTE_FLOAT, -1},
+	{"3d move z",        "/active/3d/move/z",                     DURATION_REMOTE_FLOAT, -1},
+	{"animation",        "/active/3d/animation",                  DURATION_REMOTE_INT,   -1},
+	{"smooth",           "/active/3d/texture/mode",               DURATION_REMOTE_INT,   0},
+	{"wire",             "/active/3d/texture/mode",               DURATION_REMOTE_INT,   1},
+	{"dots",             "/active/3d/texture/mode",               DURATION_REMOTE_INT,   2},
+};
+
+DurationRemoteMap::DurationRemoteMap(){
+	int numParameters = sizeof(remoteParameters) / sizeof(remoteParameters[0]);
+	for(int i = 0; i < numParameters; i++){
+		parametersByName[remoteParameters[i].widget] = &remoteParameters[i];
+	}
+}
+
+void DurationRemoteMap::addCanvas(ofxUICanvas* canvas){
+	vector<ofxUIWidget*> widgets = canvas->getWidgets();
+	for(int i = 0; i < widgets.size(); i++){
+		addWidget(widgets[i]);
+		//drop down items send their own messages
+		if(widgets[i]->getKind() == OFX_UI_WIDGET_DROPDOWNLIST){
+			vector<ofxUILabelToggle*>& toggles = ((ofxUIDropDownList*)widgets[i])->getToggles();
+			for(int t = 0; t < toggles.size(); t++){
+				addWidget(toggles[t]);
+			}
+		}
+	}
+}
+
+void DurationRemoteMap::addWidget(ofxUIWidget* widget){
+	unordered_map<string, const DurationRemoteParameter*>::iterator it = parametersByName.find(widget->getName());
+	if(it != parametersByName.end()){
+		parametersByWidget[widget] = it->second;
+	}
+}
+
+bool DurationRemoteMap::getMessage(ofxUIWidget* widget, ofxOscMessage& message, bool& continuous){
+	unordered_map<ofxUIWidget*, const DurationRemoteParameter*>::iterator it = parametersByWidget.find(widget);
+	if(it == parametersByWidget.end()){
+		return false;
+	}
+
+	const DurationRemoteParameter* parameter = it->second;
+	int kind = widget->getKind();
+	continuous = kind == OFX_UI_WIDGET_MINIMALSLIDER || kind == OFX_UI_WIDGET_SLIDER_H ||
+				 kind == OFX_UI_WIDGET_SLIDER_V || kind == OFX_UI_WIDGET_CIRCLESLIDER;
+	float value = continuous ? ((ofxUISlider*)widget)->getValue() : ((ofxUIButton*)widget)->getValue();
+
+	message.setAddress(parameter->address);
+	if(parameter->leadingInt != -1){
+		message.addIntArg(parameter->leadingInt);
+	}
+	if(parameter->type == DURATION_REMOTE_INT){
+		message.addIntArg(value);
+	}
+	else{
+		message.addFloatArg(value);
+	}
+	return true;
+}
@@ -0,0 +1,71 @@
+/**
+ * Duration
+ * Standalone timeline for Creative Code
+ *
+ * Copyright (c) 2012 James George
+ * Development Supported by YCAM InterLab http://interlab.ycam.jp/en/
+ * http://jamesgeorge.org + http://flightphase.com
+ * http://github.com/obviousjim + http://github.com/flightphase
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#pragma once
+
+#include "ofMain.h"
+#include "ofxOsc.h"
+#include "ofxUI.h"
+#include <unordered_map>
+
+enum DurationRemoteArgType {
+	DURATION_REMOTE_FLOAT,
+	DURATION_REMOTE_INT
+};
+
+//One remote panel widget and the OSC message it sends.
+//leadingInt is sent before the value when it is not -1 (drop down items)
+struct DurationRemoteParameter {
+	const char* widget;
+	const char* address;
+	DurationRemoteArgType type;
+	int leadingInt;
+};
+
+//Maps the LPMT remote panel widgets to their OSC messages. The parameter
+//table lives in DurationRemoteMap.cpp; new parameters are added there.
+class DurationRemoteMap {
+  public:
+	DurationRemoteMap();
+
+	//indexes every widget of the canvas that has an entry in the table
+	void addCanvas(ofxUICanvas* canvas);
+
+	//fills in the message for a registered widget, returns false for anything else
+	bool getMessage(ofxUIWidget* widget, ofxOscMessage& message, bool& continuous);
+
+  protected:
+	void addWidget(ofxUIWidget* widget);
+	unordered_map<string, const DurationRemoteParameter*> parametersByName;
+	unordered_map<ofxUIWidget*, const DurationRemoteParameter*> parametersByWidget;
+};
@@ -0,0 +1,101 @@
+/**
+ * Duration
+ * Standalone timeline for Creative Code
+ *
+ * Copyright (c) 2012 James George
+ * Development Supported by YCAM InterLab http://interlab.ycam.jp/en/
+ * http://jamesgeorge.org + http://flightphase.com
+ * http://github.com/obviousjim + http://github.com/flightphase
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include "DurationWakeup.h"
+
+DurationWakeup::DurationWakeup(){
+	pending = false;
+	sleeping = false;
+	notifiedTime = 0;
+	lastLatency = 0;
+	maxLatency = 0;
+}
+
+void DurationWakeup::notify(){
+	if(!pending.exchange(true)){
+		notifiedTime = ofGetElapsedTimeMicros();
+	}
+	if(sleeping){
+		std::lock_guard<std::mutex> guard(mutex);
+		condition.notify_one();
+	}
+}
+
+void DurationWakeup::wait(){
+	std::unique_lock<std::mutex> guard(mutex);
+	sleeping = true;
+	while(!pending){
+		condition.wait(guard);
+	}
+	sleeping = false;
+	wake(true, 0);
+}
+
+bool DurationWakeup::waitForMicros(unsigned long long timeout){
+	unsigned long long expected = ofGetElapsedTimeMicros() + timeout;
+	std::unique_lock<std::mutex> guard(mutex);
+	sleeping = true;
+	bool notified = pending;
+	if(!notified && timeout > 0){
+		notified = condition.wait_for(guard, std::chrono::microseconds(timeout), [this]{ return pending.load(); });
+	}
+	sleeping = false;
+	wake(notified, expected);
+	return notified;
+}
+
+void DurationWakeup::wake(bool notified, unsigned long long expected){
+	//clear before the caller drains its queues so nothing posted after this is missed
+	pending = false;
+
+	unsigned long long now = ofGetElapsedTimeMicros();
+	unsigned long long since = notified ? notifiedTime.load() : expected;
+	unsigned long long latency = now > since ? now - since : 0;
+	lastLatency = latency;
+	if(latency > maxLatency){
+		maxLatency = latency;
+	}
+}
+
+unsigned long long DurationWakeup::getLastLatencyMicros(){
+	return lastLatency;
+}
+
+unsigned long long DurationWakeup::getMaxLatencyMicros(){
+	return maxLatency;
+}
+
+void DurationWakeup::resetLatency(){
+	lastLatency = 0;
+	maxLatency = 0;
+}
@@ -0,0 +1,71 @@
+/**
+ * Duration
+ * Standalone timeline for Creative Code
+ *
+ * Copyright (c) 2012 James George
+ * Development Supported by YCAM InterLab http://interlab.ycam.jp/en/
+ * http://jamesgeorge.org + http://flightphase.com
+ * http://github.com/obviousjim + http://github.com/flightphase
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#pragma once
+
+#include "ofMain.h"
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+
+//Lets a worker thread sleep until it is notified or a deadline passes.
+//notify() only touches the mutex when the waiter is actually asleep.
+class DurationWakeup {
+  public:
+	DurationWakeup();
+
+	void notify();
+
+	//block until notified
+	void wait();
+	//block until notified or the timeout expires, returns true if notified
+	bool waitForMicros(unsigned long long timeout);
+
+	//time between a notify() and the waiter resuming, or how late a timeout fired
+	unsigned long long getLastLatencyMicros();
+	unsigned long long getMaxLatencyMicros();
+	void resetLatency();
+
+  protected:
+	void wake(bool notified, unsigned long long expected);
+
+	std::mutex mutex;
+	std::condition_variable condition;
+	std::atomic<bool> pending;
+	std::atomic<bool> sleeping;
+	std::atomic<unsigned long long> notifiedTime;
+
+	std::atomic<unsigned long long> lastLatency;
+	std::atomic<unsigned long long> maxLatency;
+};
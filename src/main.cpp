@@ -1,8 +1,31 @@
 #include "ofMain.h"
 #include "ofApp.h"
+#include "ofAppNoWindow.h"
 
 //========================================================================
-int main( ){
+int main(int argc, char* argv[]){
+
+	//--headless plays a project out over OSC without a window, for machines with no display
+	//--project <folder> opens that project instead of the last one
+	ofApp* app = new ofApp();
+	app->headless = false;
+	app->projectPath = "";
+	for(int i = 1; i < argc; i++){
+		string arg = argv[i];
+		if(arg == "--headless"){
+			app->headless = true;
+		}
+		else if(arg == "--project" && i + 1 < argc){
+			app->projectPath = argv[++i];
+		}
+	}
+
+	if(app->headless){
+		ofAppNoWindow window;
+		ofSetupOpenGL(&window, 0, 0, OF_WINDOW);
+		ofRunApp(app);
+		return 0;
+	}
 
 	ofSetupOpenGL(1300, 700, OF_WINDOW);			// <-------- setup the GL context
     ofSetWindowPosition(0, 0);
@@ -10,6 +33,6 @@ int main( ){
 	// can be OF_WINDOW or OF_FULLSCREEN
 	// pass in width and height too:
 	ofSetWindowTitle("LptmX Duration Controller by Gil@dX");
-	ofRunApp( new ofApp());
+	ofRunApp(app);
 
 }
@@ -38,6 +38,13 @@
 //--------------------------------------------------------------
 void ofApp::setup(){
 
+	//nothing is drawn headless, update still runs the controller at the frame rate
+	if(headless){
+		ofSetFrameRate(30);
+		controller.setup(true, projectPath);
+		return;
+	}
+
     ofSetVerticalSync(true);
     ofSetFrameRate(30);
     ofBackground(.10*255);
@@ -46,7 +53,7 @@ void ofApp::setup(){
     ofEnableSmoothing();
 	ofSetEscapeQuitsApp(false);
 
-	controller.setup();
+	controller.setup(false, projectPath);
 	#ifdef TARGET_OSX
 	RemoveCocoaMenusFromGlut("Duration");
 	#endif
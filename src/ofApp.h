@@ -53,6 +53,9 @@ class ofApp : public ofBaseApp{
     void gotMessage(ofMessage msg);
 
     bool bFullscreen;
+    //set from the command line before setup
+    bool headless;
+    string projectPath;
 
 	DurationController controller;
 };
@@ -48,18 +48,25 @@ ofxTLUIHeader::ofxTLUIHeader(){
 	lastInputReceivedTime = -1000;
 
 	hasReceivedValue = false;
-	hasSentValue = false;
-	lastFloatSent = 0;
-	lastBoolSent = false;
-	lastColorSent = ofColor(0,0,0);
 	lastValueReceived = 0;
+	keysDeferred = false;
 	audioNumberOfBins = 256;
 
 	bins = NULL;
 	minDialer = NULL;
 	maxDialer = NULL;
+	rateDialer = NULL;
+	sendOnChangeToggle = NULL;
+	outputRate = 0;
+	sendOnChange = true;
+	outputDeadband = 0;
+	outputDeadbandRelative = false;
+	outputQuantizeSteps = 0;
+	outputRefreshSeconds = 0;
     sendOSCEnable = NULL;
 	receiveOSCEnable = NULL;
+	sendOSCEnabled = true;
+	receiveOSCEnabled = true;
 	modified = false;
 }
 
@@ -78,6 +85,18 @@ ofxTLUIHeader::~ofxTLUIHeader(){
 
 void ofxTLUIHeader::setTrackHeader(ofxTLTrackHeader* header){
     trackHeader = header;
+    trackType = trackHeader->getTrack()->getTrackType();
+    ofAddListener(trackHeader->events().viewWasResized, this, &ofxTLUIHeader::viewWasResized);
+}
+
+bool ofxTLUIHeader::hasGui(){
+	return gui != NULL;
+}
+
+void ofxTLUIHeader::createGui(){
+	if(gui != NULL){
+		return;
+	}
 
     //create gui
     ofRectangle headerRect = trackHeader->getDrawRect();
@@ -91,8 +110,6 @@ void ofxTLUIHeader::setTrackHeader(ofxTLTrackHeader* header){
     gui->setWidgetSpacing(1);
 	gui->setPadding(0);
     //switch on track type
-
-    trackType = trackHeader->getTrack()->getTrackType();
 	if(trackType != "Audio" && trackType != "Video"){
 		ofxUILabelButton* playSolo = new ofxUILabelButton(">", false,0,0,0, OFX_UI_FONT_SMALL);
 		playSolo->setPadding(0);
@@ -136,13 +153,24 @@ void ofxTLUIHeader::setTrackHeader(ofxTLTrackHeader* header){
 	}
 
 	if(trackType == "Bangs" || trackType == "Curves"){
-		receiveOSCEnable = new ofxUIToggle(translation->translateKey("receive osc"), true, 17, 17, 0, 0, OFX_UI_FONT_SMALL);
+		receiveOSCEnable = new ofxUIToggle(translation->translateKey("receive osc"), receiveOSCEnabled, 17, 17, 0, 0, OFX_UI_FONT_SMALL);
 		receiveOSCEnable->setPadding(1);
 		gui->addWidgetRight(receiveOSCEnable);
 	}
 
+	if(trackType == "Curves" || trackType == "LFO" || trackType == "Switches" || trackType == "Colors" || trackType == "Audio"){
+		rateDialer = new ofxUINumberDialer(0., 240., outputRate, 1, "rate", OFX_UI_FONT_SMALL);
+		rateDialer->setPadding(0);
+		gui->addWidgetRight(rateDialer);
+	}
+	if(trackType == "Curves" || trackType == "LFO" || trackType == "Switches" || trackType == "Colors"){
+		sendOnChangeToggle = new ofxUIToggle(translation->translateKey("on change"), sendOnChange, 17, 17, 0, 0, OFX_UI_FONT_SMALL);
+		sendOnChangeToggle->setPadding(1);
+		gui->addWidgetRight(sendOnChangeToggle);
+	}
+
 //	if(trackType != "Audio"){ //TODO: audio should send some nice FFT OSC
-		sendOSCEnable = new ofxUIToggle(translation->translateKey("send osc"), true, 17, 17, 0, 0, OFX_UI_FONT_SMALL);
+		sendOSCEnable = new ofxUIToggle(translation->translateKey("send osc"), sendOSCEnabled, 17, 17, 0, 0, OFX_UI_FONT_SMALL);
 		sendOSCEnable->setPadding(1);
 		gui->addWidgetRight(sendOSCEnable);
 //	}
@@ -161,11 +189,13 @@ void ofxTLUIHeader::setTrackHeader(ofxTLTrackHeader* header){
     gui->getRect()->y = trackHeader->getDrawRect().y; //TWEAK to get on the header
 	gui->getRect()->x = trackHeader->getTimeline()->getTopRight().x - (gui->getRect()->width + 50);
 
-    ofAddListener(trackHeader->events().viewWasResized, this, &ofxTLUIHeader::viewWasResized);
     ofAddListener(gui->newGUIEvent, this, &ofxTLUIHeader::guiEvent);
 }
 
 void ofxTLUIHeader::viewWasResized(ofEventArgs& args){
+	if(gui == NULL){
+		return;
+	}
     gui->getRect()->y = trackHeader->getDrawRect().y; //TWEAK to get on the header
 	gui->getRect()->x = trackHeader->getTimeline()->getTopRight().x - (gui->getRect()->width + 50);
 }
@@ -207,8 +237,10 @@ void ofxTLUIHeader::viewWasResized(ofEventArgs& args){
 
 void ofxTLUIHeader::setValueRange(ofRange range){
 	if(getTrackType() == "Curves" || getTrackType() == "LFO"){
-		minDialer->setValue(range.min);
-		maxDialer->setValue(range.max);
+		if(minDialer != NULL){
+			minDialer->setValue(range.min);
+			maxDialer->setValue(range.max);
+		}
 		((ofxTLKeyframes*)getTrack())->setValueRange(range);
 	}
 	else{
@@ -218,7 +250,9 @@ void ofxTLUIHeader::setValueRange(ofRange range){
 
 void ofxTLUIHeader::setValueMin(float min){
 	if(getTrackType() == "Curves" || getTrackType() == "LFO"){
-		minDialer->setValue(min);
+		if(minDialer != NULL){
+			minDialer->setValue(min);
+		}
 		((ofxTLKeyframes*)getTrack())->setValueRangeMin(min);
 	}
 	else{
@@ -228,7 +262,9 @@ void ofxTLUIHeader::setValueMin(float min){
 
 void ofxTLUIHeader::setValueMax(float max){
 	if(getTrackType() == "Curves" || getTrackType() == "LFO"){
-		maxDialer->setValue(max);
+		if(maxDialer != NULL){
+			maxDialer->setValue(max);
+		}
 		((ofxTLKeyframes*)getTrack())->setValueRangeMin(max);
 	}
 	else{
@@ -241,25 +277,81 @@ ofxUICanvas* ofxTLUIHeader::getGui(){
 }
 
 bool ofxTLUIHeader::sendOSC(){
-	return sendOSCEnable != NULL && sendOSCEnable->getValue();
+	return sendOSCEnabled;
 }
 
 void ofxTLUIHeader::setSendOSC(bool enable){
+	sendOSCEnabled = enable;
 	if(sendOSCEnable != NULL){
 		sendOSCEnable->setValue(enable);
 	}
 }
 
 bool ofxTLUIHeader::receiveOSC(){
-	return receiveOSCEnable != NULL && receiveOSCEnable->getValue();
+	return receiveOSCEnabled && (trackType == "Bangs" || trackType == "Curves");
 }
 
 void ofxTLUIHeader::setReceiveOSC(bool enable){
+	receiveOSCEnabled = enable;
 	if(receiveOSCEnable != NULL){
 		receiveOSCEnable->setValue(enable);
 	}
 }
 
+float ofxTLUIHeader::getOutputRate(){
+	return outputRate;
+}
+
+void ofxTLUIHeader::setOutputRate(float rate){
+	outputRate = ofClamp(rate, 0, 240);
+	if(rateDialer != NULL){
+		rateDialer->setValue(outputRate);
+	}
+}
+
+bool ofxTLUIHeader::getSendOnChange(){
+	return sendOnChange;
+}
+
+void ofxTLUIHeader::setSendOnChange(bool onChange){
+	sendOnChange = onChange;
+	if(sendOnChangeToggle != NULL){
+		sendOnChangeToggle->setValue(sendOnChange);
+	}
+}
+
+float ofxTLUIHeader::getOutputDeadband(){
+	return outputDeadband;
+}
+
+void ofxTLUIHeader::setOutputDeadband(float deadband){
+	outputDeadband = MAX(deadband, 0);
+}
+
+bool ofxTLUIHeader::getOutputDeadbandRelative(){
+	return outputDeadbandRelative;
+}
+
+void ofxTLUIHeader::setOutputDeadbandRelative(bool relative){
+	outputDeadbandRelative = relative;
+}
+
+int ofxTLUIHeader::getOutputQuantizeSteps(){
+	return outputQuantizeSteps;
+}
+
+void ofxTLUIHeader::setOutputQuantizeSteps(int steps){
+	outputQuantizeSteps = MAX(steps, 0);
+}
+
+float ofxTLUIHeader::getOutputRefreshSeconds(){
+	return outputRefreshSeconds;
+}
+
+void ofxTLUIHeader::setOutputRefreshSeconds(float seconds){
+	outputRefreshSeconds = MAX(seconds, 0);
+}
+
 void ofxTLUIHeader::setShouldDelete(bool del){
 	shouldDelete = del;
 	if(shouldDelete){
@@ -370,10 +462,20 @@ void ofxTLUIHeader::guiEvent(ofxUIEventArgs &e){
      */
     //this is polled from outside
 	else if(e.widget == sendOSCEnable){
+		sendOSCEnabled = sendOSCEnable->getValue();
 		modified = true;
     }
 	else if(e.widget == receiveOSCEnable){
+		receiveOSCEnabled = receiveOSCEnable->getValue();
 		modified = true;
     }
+	else if(e.widget == rateDialer){
+		outputRate = rateDialer->getValue();
+		modified = true;
+	}
+	else if(e.widget == sendOnChangeToggle){
+		sendOnChange = sendOnChangeToggle->getValue();
+		modified = true;
+	}
 }
 
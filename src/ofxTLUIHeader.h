@@ -43,6 +43,9 @@ class ofxTLUIHeader {
     virtual ~ofxTLUIHeader();
 
     void setTrackHeader(ofxTLTrackHeader* trackHeader);
+	//the canvas is built the first time the track's page is shown
+	void createGui();
+	bool hasGui();
 	virtual void viewWasResized(ofEventArgs& args);
     virtual void guiEvent(ofxUIEventArgs &e);
 
@@ -54,28 +57,42 @@ class ofxTLUIHeader {
     virtual bool receiveOSC();
     virtual void setReceiveOSC(bool enable);
 
+	//bundles per second for this track, 0 follows the project rate
+	float getOutputRate();
+	void setOutputRate(float rate);
+	//only send when the value changed, otherwise resend every period
+	bool getSendOnChange();
+	void setSendOnChange(bool onChange);
+	//curve output filtering, kept in the track entry of the project
+	float getOutputDeadband(); //smallest change worth sending, 0 sends every change
+	void setOutputDeadband(float deadband);
+	bool getOutputDeadbandRelative(); //deadband is a fraction of the value range
+	void setOutputDeadbandRelative(bool relative);
+	int getOutputQuantizeSteps(); //snap to this many steps across the value range, 0 is off
+	void setOutputQuantizeSteps(int steps);
+	float getOutputRefreshSeconds(); //resend the current value this often, 0 is off
+	void setOutputRefreshSeconds(float seconds);
+
 //	string getPalettePath();
 
 	//just for drawing the red receiver background
 	float lastInputReceivedTime;
 
-	//remove duplicate sending and receiving
+	//remove duplicate receiving
 	bool hasReceivedValue;
-	bool hasSentValue;
-
-	//different value types for tracking last values sent over OSC
-	float lastFloatSent;
-	bool lastBoolSent;
-	ofColor lastColorSent;
 
 	//only receiving floats for now
 	float lastValueReceived;
 
+	//keys not read yet, the OSC thread leaves the track alone until the main thread has
+	//read them. changed and read with the controller locked
+	bool keysDeferred;
+
 	ofxTLTrack* getTrack();
 	ofxTLTrackHeader* getTrackHeader();
 	string getTrackType();
 	ofxLocalization* translation;
-	ofxUICanvas* getGui();
+	ofxUICanvas* getGui(); //NULL until createGui
 	bool getModified();
 
 
@@ -101,12 +118,22 @@ class ofxTLUIHeader {
 	ofxUILabelButton* palette;
 	ofxUILabelButton* audioClip;
 	ofxUILabelButton* resetRange;
+	ofxUINumberDialer* rateDialer;
+	ofxUIToggle* sendOnChangeToggle;
 	//Delay dialer?
 
     ofxUIToggle* sendOSCEnable;
 	ofxUIToggle* receiveOSCEnable;
 	bool resizeEventsEnabled;
 	int audioNumberOfBins;
+	float outputRate;
+	bool sendOnChange;
+	float outputDeadband;
+	bool outputDeadbandRelative;
+	int outputQuantizeSteps;
+	float outputRefreshSeconds;
+	bool sendOSCEnabled;
+	bool receiveOSCEnabled;
 
 	string trackType;
     bool shouldDelete;